@@ -796,6 +796,8 @@ REVOKE EXECUTE ON FUNCTION pg_ls_logicalmapdir() FROM PUBLIC;
 
 REVOKE EXECUTE ON FUNCTION pg_ls_replslotdir(text) FROM PUBLIC;
 
+REVOKE EXECUTE ON FUNCTION pg_session_variables_restore(bytea) FROM PUBLIC;
+
 --
 -- We also set up some things as accessible to standard roles.
 --
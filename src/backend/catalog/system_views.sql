@@ -925,6 +925,15 @@ CREATE VIEW pg_stat_slru AS
             s.stats_reset
     FROM pg_stat_get_slru() s;
 
+CREATE VIEW pg_stat_session_variables AS
+    SELECT
+            s.name,
+            s.type,
+            s.size,
+            s.reads,
+            s.writes
+    FROM pg_stat_get_session_variables() s;
+
 CREATE VIEW pg_stat_wal_receiver AS
     SELECT
             s.pid,
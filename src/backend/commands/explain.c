@@ -146,6 +146,8 @@ static const char *explain_get_index_name(Oid indexId);
 static bool peek_buffer_usage(ExplainState *es, const BufferUsage *usage);
 static void show_buffer_usage(ExplainState *es, const BufferUsage *usage);
 static void show_wal_usage(ExplainState *es, const WalUsage *usage);
+static void show_sesvar_usage(ExplainState *es,
+							  const SessionVariableUsage *usage);
 static void show_memory_counters(ExplainState *es,
 								 const MemoryContextCounters *mem_counters);
 static void ExplainIndexScanDetails(Oid indexid, ScanDirection indexorderdir,
@@ -215,6 +217,8 @@ ExplainQuery(ParseState *pstate, ExplainStmt *stmt,
 			es->buffers = defGetBoolean(opt);
 		else if (strcmp(opt->defname, "wal") == 0)
 			es->wal = defGetBoolean(opt);
+		else if (strcmp(opt->defname, "session_variables") == 0)
+			es->sesvars = defGetBoolean(opt);
 		else if (strcmp(opt->defname, "settings") == 0)
 			es->settings = defGetBoolean(opt);
 		else if (strcmp(opt->defname, "generic_plan") == 0)
@@ -289,6 +293,12 @@ ExplainQuery(ParseState *pstate, ExplainStmt *stmt,
 				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
 				 errmsg("EXPLAIN option WAL requires ANALYZE")));
 
+	/* check that SESSION_VARIABLES is used with EXPLAIN ANALYZE */
+	if (es->sesvars && !es->analyze)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("EXPLAIN option SESSION_VARIABLES requires ANALYZE")));
+
 	/* if the timing was not set explicitly, set default value */
 	es->timing = (timing_set) ? es->timing : es->analyze;
 
@@ -659,6 +669,8 @@ ExplainOnePlan(PlannedStmt *plannedstmt, IntoClause *into, ExplainState *es,
 		instrument_option |= INSTRUMENT_BUFFERS;
 	if (es->wal)
 		instrument_option |= INSTRUMENT_WAL;
+	if (es->sesvars)
+		instrument_option |= INSTRUMENT_SESVARS;
 
 	/*
 	 * We always collect timing for the entire statement, even when node-level
@@ -1742,6 +1754,10 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		case T_Hash:
 			pname = sname = "Hash";
 			break;
+		case T_ModifySessionVariable:
+			pname = "Set Session Variable";
+			sname = "ModifySessionVariable";
+			break;
 		default:
 			pname = sname = "???";
 			break;
@@ -2419,14 +2435,16 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		}
 	}
 
-	/* Show buffer/WAL usage */
+	/* Show buffer/WAL/session variable usage */
 	if (es->buffers && planstate->instrument)
 		show_buffer_usage(es, &planstate->instrument->bufusage);
 	if (es->wal && planstate->instrument)
 		show_wal_usage(es, &planstate->instrument->walusage);
+	if (es->sesvars && planstate->instrument)
+		show_sesvar_usage(es, &planstate->instrument->sesvarusage);
 
-	/* Prepare per-worker buffer/WAL usage */
-	if (es->workers_state && (es->buffers || es->wal) && es->verbose)
+	/* Prepare per-worker buffer/WAL/session variable usage */
+	if (es->workers_state && (es->buffers || es->wal || es->sesvars) && es->verbose)
 	{
 		WorkerInstrumentation *w = planstate->worker_instrument;
 
@@ -2443,6 +2461,8 @@ ExplainNode(PlanState *planstate, List *ancestors,
 				show_buffer_usage(es, &instrument->bufusage);
 			if (es->wal)
 				show_wal_usage(es, &instrument->walusage);
+			if (es->sesvars)
+				show_sesvar_usage(es, &instrument->sesvarusage);
 			ExplainCloseWorker(n, es);
 		}
 	}
@@ -3442,6 +3462,12 @@ show_hash_info(HashState *hashstate, ExplainState *es)
 											  worker_hi->nbatch_original);
 			hinstrument.space_peak = Max(hinstrument.space_peak,
 										 worker_hi->space_peak);
+			hinstrument.bloom_space = Max(hinstrument.bloom_space,
+										  worker_hi->bloom_space);
+			hinstrument.bloom_checked = Max(hinstrument.bloom_checked,
+											worker_hi->bloom_checked);
+			hinstrument.bloom_rejected = Max(hinstrument.bloom_rejected,
+											 worker_hi->bloom_rejected);
 		}
 	}
 
@@ -3483,6 +3509,30 @@ show_hash_info(HashState *hashstate, ExplainState *es)
 							 spacePeakKb);
 		}
 	}
+
+	if (hinstrument.bloom_space > 0)
+	{
+		uint64		bloomSpaceKb = BYTES_TO_KILOBYTES(hinstrument.bloom_space);
+
+		if (es->format != EXPLAIN_FORMAT_TEXT)
+		{
+			ExplainPropertyUInteger("Bloom Filter Size", "kB",
+									bloomSpaceKb, es);
+			ExplainPropertyFloat("Bloom Filter Checked", NULL,
+								 hinstrument.bloom_checked, 0, es);
+			ExplainPropertyFloat("Bloom Filter Rejected", NULL,
+								 hinstrument.bloom_rejected, 0, es);
+		}
+		else
+		{
+			ExplainIndentText(es);
+			appendStringInfo(es->str,
+							 "Bloom Filter: " UINT64_FORMAT "kB  Checked: %.0f  Rejected: %.0f\n",
+							 bloomSpaceKb,
+							 hinstrument.bloom_checked,
+							 hinstrument.bloom_rejected);
+		}
+	}
 }
 
 /*
@@ -4263,6 +4313,55 @@ show_wal_usage(ExplainState *es, const WalUsage *usage)
 	}
 }
 
+/*
+ * Show session variable usage details.
+ */
+static void
+show_sesvar_usage(ExplainState *es, const SessionVariableUsage *usage)
+{
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		/* Show only positive counter values. */
+		if ((usage->sesvar_reads > 0) || (usage->sesvar_writes > 0) ||
+			(usage->sesvar_coercions > 0) || (usage->sesvar_bytes > 0) ||
+			(usage->sesvar_invalidations > 0))
+		{
+			ExplainIndentText(es);
+			appendStringInfoString(es->str, "Session Variables:");
+
+			if (usage->sesvar_reads > 0)
+				appendStringInfo(es->str, " reads=%lld",
+								 (long long) usage->sesvar_reads);
+			if (usage->sesvar_writes > 0)
+				appendStringInfo(es->str, " writes=%lld",
+								 (long long) usage->sesvar_writes);
+			if (usage->sesvar_coercions > 0)
+				appendStringInfo(es->str, " coercions=%lld",
+								 (long long) usage->sesvar_coercions);
+			if (usage->sesvar_bytes > 0)
+				appendStringInfo(es->str, " bytes=" UINT64_FORMAT,
+								 usage->sesvar_bytes);
+			if (usage->sesvar_invalidations > 0)
+				appendStringInfo(es->str, " invalidations=%lld",
+								 (long long) usage->sesvar_invalidations);
+			appendStringInfoChar(es->str, '\n');
+		}
+	}
+	else
+	{
+		ExplainPropertyInteger("Session Variable Reads", NULL,
+							   usage->sesvar_reads, es);
+		ExplainPropertyInteger("Session Variable Writes", NULL,
+							   usage->sesvar_writes, es);
+		ExplainPropertyInteger("Session Variable Coercions", NULL,
+							   usage->sesvar_coercions, es);
+		ExplainPropertyUInteger("Session Variable Bytes", NULL,
+								usage->sesvar_bytes, es);
+		ExplainPropertyInteger("Session Variable Invalidations", NULL,
+							   usage->sesvar_invalidations, es);
+	}
+}
+
 /*
  * Show memory usage details.
  */
@@ -699,8 +699,8 @@ pg_prepared_statement(PG_FUNCTION_ARGS)
 		while ((prep_stmt = hash_seq_search(&hash_seq)) != NULL)
 		{
 			TupleDesc	result_desc;
-			Datum		values[8];
-			bool		nulls[8] = {0};
+			Datum		values[9];
+			bool		nulls[9] = {0};
 
 			result_desc = prep_stmt->plansource->resultDesc;
 
@@ -726,6 +726,7 @@ pg_prepared_statement(PG_FUNCTION_ARGS)
 			values[5] = BoolGetDatum(prep_stmt->from_sql);
 			values[6] = Int64GetDatumFast(prep_stmt->plansource->num_generic_plans);
 			values[7] = Int64GetDatumFast(prep_stmt->plansource->num_custom_plans);
+			values[8] = Int64GetDatumFast(prep_stmt->plansource->num_sesvar_invalidations);
 
 			tuplestore_putvalues(rsinfo->setResult, rsinfo->setDesc,
 								 values, nulls);
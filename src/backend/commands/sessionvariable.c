@@ -17,22 +17,30 @@
 
 #include <ctype.h>
 
+#include "access/detoast.h"
 #include "access/htup_details.h"
 #include "access/parallel.h"
 #include "access/session.h"
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "access/xlogprefetcher.h"
+#include "funcapi.h"
 #include "catalog/pg_authid.h"
 #include "commands/sessionvariable.h"
 #include "common/string.h"
+#include "lib/dshash.h"
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
 #include "postmaster/postmaster.h"
 #include "postmaster/syslogger.h"
 #include "storage/bufmgr.h"
+#include "storage/lwlock.h"
+#include "storage/proc.h"
+#include "storage/shmem.h"
 #include "utils/acl.h"
+#include "utils/array.h"
 #include "utils/backend_status.h"
+#include "utils/builtins.h"
 #include "utils/datetime.h"
 #include "utils/dynahash.h"
 #include "utils/fmgrprotos.h"
@@ -49,37 +57,193 @@
 #include "rewrite/rewriteHandler.h"
 #include "tcop/tcopprot.h"
 #include "executor/executor.h"
+#include "executor/instrument.h"
 #include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/inval.h"
+#include "optimizer/optimizer.h"
 
 void initSessionVariables(void);
 
-void saveSessionVariable(sessionVariable *result, Node *expr, bool exists, List *indirection, bool new_strict_type);
+void saveSessionVariable(sessionVariable *result, Node *expr, bool exists, SessionVariableSubscripts *subscripts, bool new_strict_type);
+
+static void handleArrayIndirection(sessionVariable *result, Node *expr, SessionVariableSubscripts *subscripts);
+
+static sessionVariable *syncGlobalVariable(char *name, sessionVariable *variable);
+
+static void assignGlobalVariable(char *varname, Node *expr, SessionVariableSubscripts *subscripts, bool new_strict_type);
+
+static void checkSessionVariableAssignment(void);
 
 /*
- * Returns Const value of a session variable
+ * By-reference values of session variables are handed out to the executor
+ * without copying them (see readSessionVariableRef). Such a value is pinned
+ * until the memory context it was read into gets reset, because that is as
+ * long as a copy made by the reader would have lived.
+ *
+ * If the variable is reassigned while its value is pinned, the old value is
+ * retired: it is detached from the variable and freed by the last unpin.
+ */
+typedef struct SessionVariablePin
+{
+    Const      *value;          /* the pinned value */
+    int         refcount;       /* # of contexts the value was read into */
+    bool        retired;        /* value no longer belongs to the variable */
+    MemoryContext context;      /* context of the most recent pin, or NULL */
+} SessionVariablePin;
+
+/* Registered in each memory context the pinned value was read into */
+typedef struct SessionVariablePinCallback
+{
+    MemoryContextCallback callback;
+    SessionVariablePin *pin;
+    MemoryContext context;
+} SessionVariablePinCallback;
+
+/*
+ * All memory of session variables lives under this context.
+ *
+ * The hash table, pins and Consts of by-value (or NULL) values are allocated
+ * in it directly. Every by-reference value gets a small child context of its
+ * own ("Session variable", identified by the variable name) so that it can be
+ * freed wholesale when the variable is reassigned.
+ */
+static MemoryContext SessionVariablesContext = NULL;
+
+/*
+ * Generation of the session variable table.
+ *
+ * Bumped whenever slots of CurrentSession->variables may have been freed,
+ * which invalidates all slots cached in SessionVariableRef.
+ */
+static uint64 sessionVariablesGeneration = 0;
+
+/*
+ * Memory held by the values of all session variables of the backend,
+ * the sum of sessionVariable->size. Checked against
+ * session_variables_memory_limit whenever a new value is saved.
+ */
+static Size sessionVariablesMemory = 0;
+
+int session_variables_memory_limit = -1;
+
+/*
+ * Hook run before the session variable table is accessed.
+ *
+ * Used by PL/pgSQL, which defers the write-back of @var assignments,
+ * to flush them before anyone else gets to see the table.
+ */
+session_variable_flush_hook_type session_variable_flush_hook = NULL;
+
+#define FlushPendingSessionVariables() \
+    do { \
+        if (session_variable_flush_hook) \
+            session_variable_flush_hook(); \
+    } while (0)
+
+/*
+ * Global variables (@@var) are kept in a shared hash table, each entry points
+ * to the current version of the value of the variable.  Versions are never
+ * changed once published: an assignment serializes the new value into a new
+ * GlobalVariableValue and swaps the pointer of the entry (see
+ * assignGlobalVariable), the replaced version is retired.
+ *
+ * Every backend reads them through a local copy living in the session
+ * variable table, so reads cost the same as reads of session variables.
+ * Assignments bump the shared generation once published, the local copy is
+ * refreshed only when the generation moved on since it was last checked,
+ * which is a single atomic read.  Refreshing takes no lock either: the
+ * reader announces the version it is about to copy in its hazard slot, and
+ * retired versions are freed only once no hazard slot points to them (see
+ * syncGlobalVariable and retireGlobalVariableValue).
+ */
+typedef struct GlobalVariablesCtxStruct
+{
+    dsa_handle  dsah;
+    dshash_table_handle dshh;
+    pg_atomic_uint64 generation;    /* bumped by every assignment */
+    pg_atomic_uint64 memory;        /* bytes of all versions not freed yet */
+    dsa_pointer retired;            /* replaced versions still being read,
+                                     * protected by GlobalVariablesLock */
+    dsa_pointer_atomic hazards[FLEXIBLE_ARRAY_MEMBER]; /* version each process
+                                                        * is copying, by
+                                                        * ProcNumber */
+} GlobalVariablesCtxStruct;
+
+typedef struct GlobalVariableEntry
+{
+    char        key[SESVAR_SIZE];   /* @@var */
+    dsa_pointer_atomic value;       /* current GlobalVariableValue, or
+                                     * InvalidDsaPointer */
+} GlobalVariableEntry;
+
+/*
+ * A published version of a global variable, followed by the value
+ * serialized by serializeSessionVariableValue.
+ */
+typedef struct GlobalVariableValue
+{
+    uint64      version;            /* 1 for the first value of the entry,
+                                     * incremented by every assignment */
+    Size        size;               /* allocated size, including the header */
+    dsa_pointer next;               /* next retired version */
+} GlobalVariableValue;
+
+#define GlobalVariableValueData(value) \
+    ((char *) (value) + MAXALIGN(sizeof(GlobalVariableValue)))
+
+#define NumGlobalVariableHazards (MaxBackends + NUM_AUXILIARY_PROCS)
+
+int global_variables_memory_limit = -1;
+
+static const dshash_parameters globalVariablesParams = {
+    SESVAR_SIZE,
+    sizeof(GlobalVariableEntry),
+    dshash_strcmp,
+    dshash_strhash,
+    dshash_strcpy,
+    LWTRANCHE_GLOBAL_VARIABLES_HASH
+};
+
+static GlobalVariablesCtxStruct *GlobalVariablesCtx = NULL;
+static dsa_area *globalVariablesArea = NULL;
+static dshash_table *globalVariablesTable = NULL;
+
+/*
+ * Returns the slot of the given session (or global) variable,
+ * or NULL if the variable has no value.
+ **/
+static sessionVariable *
+findSessionVariable(char *name) {
+    sessionVariable *variable = NULL;
+
+    FlushPendingSessionVariables();
+
+    if (CurrentSession != NULL && CurrentSession->variables != NULL)
+        variable = (sessionVariable *) hash_search(CurrentSession->variables, name, HASH_FIND, NULL);
+
+    if (IsGlobalVariableName(name))
+        variable = syncGlobalVariable(name, variable);
+
+    if (!variable || !variable->expr)
+        return NULL;
+
+    return variable;
+}
+
+/*
+ * Returns Const value of the session variable stored in the given slot
  * type allows you to define the desired type you want the Const to be coerced to.
- * If the value can not be coerced returns NULL.
  * To skip coercion set type = UNKNOWNOID
  **/
-Const *
-getConstSessionVariable(char *name, Oid type) {
+static Const *
+getConstFromSessionVariable(sessionVariable *variable, Oid type) {
     Const *result;
     Node * coerced = NULL;
-    sessionVariable *variable;
     Oid outputFunction;
     bool typeIsVarlen;
     char *cstringValue;
 
-    if (CurrentSession == NULL || CurrentSession->variables == NULL)
-        return NULL;
-
-    variable = (sessionVariable *) hash_search(CurrentSession->variables, name, HASH_FIND, NULL);
-
-    if (!variable)
-        return NULL;
-
     result = (Const *) variable->expr;
 
     /* UNKNOWNOID if you just want to return the current value
@@ -115,11 +279,46 @@ getConstSessionVariable(char *name, Oid type) {
                               COERCION_IMPLICIT,
                               COERCE_IMPLICIT_CAST,
                               -1);
+
+        pgSesVarUsage.sesvar_coercions++;
     }
 
     return coerced ? (Const *) coerced : (Const *) variable->expr;
 }
 
+/*
+ * Returns Const value of a session variable
+ * type allows you to define the desired type you want the Const to be coerced to.
+ * If the value can not be coerced returns NULL.
+ * To skip coercion set type = UNKNOWNOID
+ **/
+Const *
+getConstSessionVariable(char *name, Oid type) {
+    sessionVariable *variable = findSessionVariable(name);
+
+    if (!variable)
+        return NULL;
+
+    return getConstFromSessionVariable(variable, type);
+}
+
+/*
+ * Same as getConstSessionVariable but resolves the variable through
+ * a SessionVariableRef, which avoids hashing the name on repeated calls.
+ **/
+Const *
+getConstSessionVariableRef(SessionVariableRef *ref, Oid type) {
+    sessionVariable *variable = lookupSessionVariable(ref);
+
+    if (!variable)
+        return NULL;
+
+    variable->reads++;
+    pgSesVarUsage.sesvar_reads++;
+
+    return getConstFromSessionVariable(variable, type);
+}
+
 /*
  * Returns Param node of SESVAR
  * 
@@ -130,14 +329,9 @@ getConstSessionVariable(char *name, Oid type) {
 Param *
 getParamSessionVariable(char *name) {
     Param *param = makeNode(Param);
-    sessionVariable *variable;
+    sessionVariable *variable = findSessionVariable(name);
     Const *con;
 
-    if (CurrentSession == NULL || CurrentSession->variables == NULL)
-        initSessionVariables();
-
-    variable = (sessionVariable *) hash_search(CurrentSession->variables, name, HASH_FIND, NULL);
-
     param->paramkind = PARAM_SESSION_VARIABLE;
     param->paramsesvarid = name;
 
@@ -149,7 +343,7 @@ getParamSessionVariable(char *name) {
      * 
      * If the sesvar has not been initiated before this variable is evaluated we will throw ERROR: unrecognized.
      **/
-    if (!variable || !variable->expr) {
+    if (!variable) {
         param->paramtype = UNKNOWNOID;
         param->paramtypmod = -1;
         param->paramcollid = InvalidOid;
@@ -164,6 +358,218 @@ getParamSessionVariable(char *name) {
     return param;
 }
 
+/*
+ * Frees a Const owned by the session variable store together with its value.
+ **/
+static void
+freeSessionVariableValue(Const *value) {
+    MemoryContext valueContext = GetMemoryChunkContext(value);
+
+    if (valueContext == SessionVariablesContext)
+        pfree(value);
+    else
+        MemoryContextDelete(valueContext);
+}
+
+/*
+ * Memory context reset callback releasing one pin of a session variable value.
+ **/
+static void
+unpinSessionVariableValue(void *arg) {
+    SessionVariablePinCallback *cb = (SessionVariablePinCallback *) arg;
+    SessionVariablePin *pin = cb->pin;
+
+    if (pin->context == cb->context)
+        pin->context = NULL;
+
+    if (--pin->refcount == 0 && pin->retired) {
+        freeSessionVariableValue(pin->value);
+        pfree(pin);
+    }
+}
+
+/*
+ * Keeps the current value of the variable alive until CurrentMemoryContext
+ * is reset, so that it can be handed out by reference.
+ **/
+static void
+pinSessionVariableValue(sessionVariable *variable) {
+    SessionVariablePin *pin = variable->pin;
+    SessionVariablePinCallback *cb;
+
+    if (pin == NULL) {
+        pin = (SessionVariablePin *) MemoryContextAlloc(SessionVariablesContext, sizeof(SessionVariablePin));
+        pin->value = (Const *) variable->expr;
+        pin->refcount = 0;
+        pin->retired = false;
+        pin->context = NULL;
+
+        variable->pin = pin;
+    } else if (pin->context == CurrentMemoryContext) {
+        /* Already pinned until this context is reset */
+        return;
+    }
+
+    cb = (SessionVariablePinCallback *) palloc(sizeof(SessionVariablePinCallback));
+    cb->pin = pin;
+    cb->context = CurrentMemoryContext;
+    cb->callback.func = unpinSessionVariableValue;
+    cb->callback.arg = (void *) cb;
+    MemoryContextRegisterResetCallback(CurrentMemoryContext, &cb->callback);
+
+    pin->refcount++;
+    pin->context = CurrentMemoryContext;
+}
+
+/*
+ * Detaches the current value from the variable and frees it,
+ * unless somebody still reads it by reference.
+ **/
+static void
+releaseSessionVariableValue(sessionVariable *variable) {
+    SessionVariablePin *pin = variable->pin;
+
+    if (pin == NULL) {
+        freeSessionVariableValue((Const *) variable->expr);
+    } else if (pin->refcount > 0) {
+        /* Freed by the last unpinSessionVariableValue */
+        pin->retired = true;
+    } else {
+        freeSessionVariableValue(pin->value);
+        pfree(pin);
+    }
+
+    sessionVariablesMemory -= variable->size;
+    variable->size = 0;
+    variable->pin = NULL;
+    variable->expr = NULL;
+}
+
+/*
+ * Sets up the conversion of values stored as source to the target type.
+ *
+ * A value read as another type is converted as if it was printed and read
+ * back, the same rule getConstFromSessionVariable applies to Consts, so that
+ * a read gives the same answer whether it is folded or executed. Binary
+ * coercible types need no conversion at all, otherwise the output and input
+ * functions are looked up once and called directly.
+ *
+ * The FmgrInfos live in a small context of their own, which is reset every
+ * time the stored or requested type changes.
+ **/
+static void
+setupSessionVariableCast(SessionVariableRef *ref, Oid source, Oid target) {
+    Oid funcId;
+    Oid inputFunction;
+    bool typeIsVarlen;
+
+    ref->castsource = source;
+    ref->casttarget = target;
+
+    if (find_coercion_pathway(target, source, COERCION_IMPLICIT, &funcId) == COERCION_PATH_RELABELTYPE &&
+        get_typtype(target) != TYPTYPE_DOMAIN) {
+        ref->castmethod = SESVAR_CAST_RELABEL;
+        return;
+    }
+
+    if (get_typtype(target) == TYPTYPE_PSEUDO) {
+        /* Polymorphic and other special targets are left to coerce_type */
+        ref->castmethod = SESVAR_CAST_COERCE;
+        return;
+    }
+
+    if (ref->castcontext == NULL)
+        ref->castcontext = AllocSetContextCreate(GetMemoryChunkContext(ref),
+                                                 "session variable cast",
+                                                 ALLOCSET_SMALL_SIZES);
+    else
+        MemoryContextReset(ref->castcontext);
+
+    /* Values stored as UNKNOWN are kept as cstrings already */
+    if (source != UNKNOWNOID) {
+        getTypeOutputInfo(source, &funcId, &typeIsVarlen);
+        fmgr_info_cxt(funcId, &ref->castoutput, ref->castcontext);
+    }
+
+    /* Domain targets get their constraints checked by domain_in */
+    getTypeInputInfo(target, &inputFunction, &ref->castioparam);
+    fmgr_info_cxt(inputFunction, &ref->castinput, ref->castcontext);
+
+    ref->castmethod = SESVAR_CAST_IO;
+}
+
+/*
+ * Reads the value of a session variable for the executor.
+ *
+ * Unlike getConstSessionVariableRef the value is not copied: by-reference
+ * values are pinned instead and stay valid until CurrentMemoryContext is
+ * reset, even if the variable gets reassigned in the meantime.
+ * Returns false if the variable does not exist.
+ **/
+bool
+readSessionVariableRef(SessionVariableRef *ref, Oid type, Datum *value, bool *isnull) {
+    sessionVariable *variable = lookupSessionVariable(ref);
+    Const *con;
+
+    if (!variable)
+        return false;
+
+    variable->reads++;
+    pgSesVarUsage.sesvar_reads++;
+
+    con = (Const *) variable->expr;
+
+    *isnull = con->constisnull;
+    *value = con->constisnull ? (Datum) 0 : con->constvalue;
+
+    if (con->constisnull)
+        return true;
+
+    if (type != UNKNOWNOID && type != con->consttype) {
+        if (ref->castsource != con->consttype || ref->casttarget != type)
+            setupSessionVariableCast(ref, con->consttype, type);
+
+        switch (ref->castmethod) {
+            case SESVAR_CAST_RELABEL:
+                break;
+            case SESVAR_CAST_IO:
+                {
+                    char *cstringValue;
+
+                    if (con->consttype == UNKNOWNOID)
+                        cstringValue = DatumGetCString(con->constvalue);
+                    else
+                        cstringValue = OutputFunctionCall(&ref->castoutput, con->constvalue);
+
+                    *value = InputFunctionCall(&ref->castinput, cstringValue, ref->castioparam, -1);
+                    pgSesVarUsage.sesvar_coercions++;
+                    return true;
+                }
+            default:
+                {
+                    /* Coerced values are computed in CurrentMemoryContext already */
+                    Const *coerced = getConstFromSessionVariable(variable, type);
+
+                    if (coerced != con) {
+                        *isnull = coerced->constisnull;
+                        *value = coerced->constvalue;
+                        return true;
+                    }
+                    break;
+                }
+        }
+    }
+
+    if (!con->constbyval) {
+        pinSessionVariableValue(variable);
+
+        /* Stored expanded arrays must not be modified by the reader */
+        *value = MakeExpandedObjectReadOnly(*value, false, con->constlen);
+    }
+
+    return true;
+}
+
 Node *
 makeConstSessionVariable(Oid typid, int32 typmod, Oid collid, bool typByVal, int16 typLen, bool isnull, Datum value) {
     Const *expr;
@@ -180,138 +586,379 @@ makeConstSessionVariable(Oid typid, int32 typmod, Oid collid, bool typByVal, int
     return (Node *) expr;
 }
 
-void handleArrayIndirection(sessionVariable *result, Node *expr, bool exists, A_Indices *indirection) {
-    Oid array_type;
+/*
+ * Session variables of array types are stored as expanded arrays so that
+ * @arr[i] := x can update the element in place (see handleArrayIndirection).
+ *
+ * Only true array types qualify, not domains over arrays nor types like
+ * int2vector that merely share the array representation.
+ **/
+static bool
+isExpandableSessionVariable(Const *con) {
+    Oid elem_type;
+
+    if (con->constisnull || con->constlen != -1)
+        return false;
+
+    elem_type = get_element_type(con->consttype);
+
+    return elem_type != InvalidOid && get_array_type(elem_type) == con->consttype;
+}
+
+/*
+ * Memory held by a Const owned by the session variable store.
+ *
+ * Only by-reference values are counted, they own a context of their own
+ * (see copySessionVariableValue) which is what pg_backend_memory_contexts
+ * reports for them as well.
+ **/
+static Size
+sessionVariableValueSize(Const *value) {
+    MemoryContext valueContext = GetMemoryChunkContext(value);
+
+    if (valueContext == SessionVariablesContext)
+        return 0;
+
+    return MemoryContextMemAllocated(valueContext, true);
+}
+
+/*
+ * Size of the data of a non-NULL value.
+ *
+ * Expanded objects count with their flat size, the size of the datum itself
+ * would be the one of the expanded pointer.  Likewise TOASTed values count
+ * with their raw size.
+ **/
+static Size
+sessionVariableDatumSize(Const *value) {
+    Assert(!value->constisnull);
+
+    if (value->constlen == -1 && VARATT_IS_EXTERNAL_EXPANDED(DatumGetPointer(value->constvalue)))
+        return EOH_get_flat_size(DatumGetEOHP(value->constvalue));
+
+    if (value->constlen == -1)
+        return toast_raw_datum_size(value->constvalue);
+
+    return datumGetSize(value->constvalue, value->constbyval, value->constlen);
+}
+
+static void
+reportSessionVariableMemory(const char *name, Size total) {
+    ereport(ERROR,
+            (errcode(ERRCODE_CONFIGURATION_LIMIT_EXCEEDED),
+             errmsg("session variables memory exceeds session_variables_memory_limit (%dkB)",
+                    session_variables_memory_limit),
+             errdetail("Assigning session variable \"%s\" would use %zu bytes in total.",
+                       name, total)));
+}
+
+/*
+ * Checks the new value of the variable, which is going to replace the current
+ * one, against session_variables_memory_limit and returns its size.
+ *
+ * The new value is freed before failing. Values that do not grow are always
+ * accepted so that a variable can be shrunk even above the limit.
+ **/
+static Size
+checkSessionVariableMemory(sessionVariable *variable, Const *value) {
+    Size size = sessionVariableValueSize(value);
+    Size total = sessionVariablesMemory - variable->size + size;
+
+    if (session_variables_memory_limit >= 0 && size > variable->size &&
+        total > (Size) session_variables_memory_limit * 1024) {
+        freeSessionVariableValue(value);
+        reportSessionVariableMemory(variable->key, total);
+    }
+
+    return size;
+}
+
+/*
+ * Builds the Const stored in the session variable from the given one.
+ * By-reference values are copied into a new context of their own.
+ *
+ * Varlena values are detoasted on the way, a TOAST pointer would not outlive
+ * the row it was read from (and means nothing outside of the database).
+ **/
+static Const *
+copySessionVariableValue(Const *con, const char *name) {
+    MemoryContext valueContext = SessionVariablesContext;
+    MemoryContext oldContext;
+    Const *result;
+
+    if (!con->constbyval && !con->constisnull) {
+        valueContext = AllocSetContextCreate(SessionVariablesContext,
+                                             "Session variable",
+                                             ALLOCSET_SMALL_SIZES);
+        MemoryContextCopyAndSetIdentifier(valueContext, name);
+    }
+
+    oldContext = MemoryContextSwitchTo(valueContext);
+
+    if (isExpandableSessionVariable(con)) {
+        result = (Const *) makeConstSessionVariable(con->consttype, con->consttypmod, con->constcollid,
+                                                    false, -1, false,
+                                                    expand_array(con->constvalue, valueContext, NULL));
+    } else if (con->constlen == -1 && !con->constisnull) {
+        result = (Const *) makeConstSessionVariable(con->consttype, con->consttypmod, con->constcollid,
+                                                    false, -1, false,
+                                                    PointerGetDatum(PG_DETOAST_DATUM_COPY(con->constvalue)));
+    } else
+        result = (Const *) copyObject(con);
+
+    MemoryContextSwitchTo(oldContext);
+
+    if (!result->constbyval && !result->constisnull)
+        pgSesVarUsage.sesvar_bytes += sessionVariableDatumSize(result);
+
+    return result;
+}
+
+static void
+handleArrayIndirection(sessionVariable *result, Node *expr, SessionVariableSubscripts *subscripts) {
+    Const *con = (Const *) result->expr;
     Oid elem_type;
-    ArrayType *array;
-    ArrayType *new_array;
-    int ndim;
-    int *dims;
+    ExpandedArrayHeader *eah;
+    Datum elem_value;
     int nelems;
     int lidx, uidx;
-    Node *subexpr;
+    int indx[MAXDIM];
     int16 elmlen;
     bool  elmbyval;
     char  elmalign;
-    Datum *elem_values;
-    Datum new_datum;
-    bool *elem_nulls;
-    Oid outputFunction;
-    bool typeIsVarlen;
-    char *cstringValue;
-    ParseState *pstate = make_parsestate(NULL);
+    Size size;
   
-    array_type = ((Const *) result->expr)->consttype;
-    elem_type = get_element_type(array_type);
+    elem_type = get_element_type(con->consttype);
     
     if(((Const *) expr)->constisnull)
         elog(ERROR, "Can not assign NULL value as an array item");
+
+    if(con->constisnull)
+        elog(ERROR, "Can not use array indirection on NULL value.");
     
-    array = DatumGetArrayTypeP(((Const *) result->expr)->constvalue);
-    ndim = ARR_NDIM(array);
-    dims = ARR_DIMS(array);
-    nelems = ArrayGetNItems(ndim, dims);
-    
-    /* Get indirection array index */
-    subexpr = transformExpr(pstate, indirection->uidx, EXPR_KIND_SELECT_TARGET);
-    subexpr = coerce_to_target_type(pstate,
-                                    subexpr, exprType(subexpr),
-                                    INT4OID, -1,
-                                    COERCION_ASSIGNMENT,
-                                    COERCE_IMPLICIT_CAST,
-                                    -1);
-    uidx = lidx = DatumGetInt32(((Const *) subexpr)->constvalue) - 1;
-    if(indirection->lidx != NULL) {
-        subexpr = transformExpr(pstate, indirection->lidx, EXPR_KIND_SELECT_TARGET);
-        subexpr = coerce_to_target_type(pstate,
-                                        subexpr, exprType(subexpr),
-                                        INT4OID, -1,
-                                        COERCION_ASSIGNMENT,
-                                        COERCE_IMPLICIT_CAST,
-                                        -1);
-        lidx = DatumGetInt32(((Const *) subexpr)->constvalue) - 1;
+    /* Subscripts come evaluated from the expression, make them 0-based */
+    lidx = subscripts->lower - 1;
+    uidx = subscripts->upper - 1;
+
+    /*
+     * Update the stored expanded array in place. If the current value is
+     * being read by reference somewhere, or is not expanded for some reason,
+     * switch the variable to a private expanded copy first.
+     */
+    if ((result->pin != NULL && result->pin->refcount > 0) ||
+        !VARATT_IS_EXTERNAL_EXPANDED_RW(DatumGetPointer(con->constvalue))) {
+        Const *copy = copySessionVariableValue(con, result->key);
+
+        if (!VARATT_IS_EXTERNAL_EXPANDED_RW(DatumGetPointer(copy->constvalue)))
+            elog(ERROR, "Can not use array indirection on non-array value.");
+
+        size = checkSessionVariableMemory(result, copy);
+        releaseSessionVariableValue(result);
+        result->expr = (Node *) copy;
+        result->size = size;
+        sessionVariablesMemory += size;
+        con = copy;
     }
+
+    eah = DatumGetExpandedArray(con->constvalue);
+    nelems = ArrayGetNItems(eah->ndims, eah->dims);
             
     if(uidx >= nelems || lidx < 0 || uidx < 0 || lidx > uidx)
         elog(ERROR, "Array indirection out of bounds.");
     
     get_typlenbyvalalign(elem_type, &elmlen, &elmbyval, &elmalign);
-    deconstruct_array(array, elem_type, elmlen, elmbyval, elmalign,
-                      &elem_values, &elem_nulls, &nelems);
-    
-    for(int i = lidx; i <= uidx; ++i)
-        elem_values[i] = ((Const *) expr)->constvalue;
-    
-    new_array = construct_array(elem_values, nelems,
-                                elem_type, elmlen, elmbyval, elmalign);
-    new_datum = PointerGetDatum(new_array);
 
-    saveSessionVariable(result, makeConstSessionVariable(array_type, -1, InvalidOid,
-                                                         false, -1, false, new_datum), true, NIL, false);
-}
-
-void
-saveSessionVariable(sessionVariable *result, Node *expr, bool exists, List *indirection, bool new_strict_type) {
-    MemoryContext oldContext;
-    Node * oldExpr = NULL;
+    elem_value = ((Const *) expr)->constvalue;
+    if (elmlen == -1)
+        elem_value = PointerGetDatum(PG_DETOAST_DATUM(elem_value));
 
-    Assert(result);
-
-    if(indirection != NIL) {
-        handleArrayIndirection(result, expr, exists, (A_Indices *) linitial(indirection));
-        return;
-    }
-    
-    if (exists) {
-        /* Invalidate cached plans if we are changing data type */
-        if (((Const *) result->expr)->consttype != ((Const *) expr)->consttype)
-            InvalidateSesvarCache(result->key);
+    /*
+     * By-reference elements are copied into the array, while the space of the
+     * replaced ones is not necessarily given back. Refuse the assignment
+     * before the array is touched if that could exceed the limit.
+     **/
+    if (!elmbyval && session_variables_memory_limit >= 0) {
+        Size total = add_size(sessionVariablesMemory,
+                              mul_size(uidx - lidx + 1, datumGetSize(elem_value, false, elmlen)));
 
-        oldExpr = result->expr;
-        if(new_strict_type)
-            result->strict_type = true;
-        
-        if (!new_strict_type && result->strict_type && ((Const *) result->expr)->consttype != ((Const *) expr)->consttype)
-            expr = coerce_type(NULL,
-                               expr,
-                               ((Const *) expr)->consttype,
-                               ((Const *) result->expr)->consttype,
-                               -1,
-                               COERCION_IMPLICIT,
-                               COERCE_IMPLICIT_CAST,
-                               -1);
+        if (total > (Size) session_variables_memory_limit * 1024)
+            reportSessionVariableMemory(result->key, total);
     }
 
-    oldContext = MemoryContextSwitchTo(TopMemoryContext);
+    /*
+     * Indexes address the elements in storage order regardless of the number
+     * of dimensions -> translate them to subscripts of the array.
+     */
+    for(int i = lidx; i <= uidx; ++i) {
+        int rest = i;
 
-    result->expr = (Node *) copyObject(expr);
+        for (int d = eah->ndims - 1; d >= 0; --d) {
+            indx[d] = eah->lbound[d] + rest % eah->dims[d];
+            rest /= eah->dims[d];
+        }
 
-    MemoryContextSwitchTo(oldContext);
+        array_set_element(con->constvalue, eah->ndims, indx, elem_value, false,
+                          -1, elmlen, elmbyval, elmalign);
+    }
 
-    /* Free old Expr-Node if we rewrote it with new data */
-    if (oldExpr)
-        pfree(oldExpr);
+    /* The check above was an upper bound, account for what was really used */
+    size = sessionVariableValueSize(con);
+    sessionVariablesMemory = sessionVariablesMemory - result->size + size;
+    result->size = size;
 }
 
-void
-initSessionVariables() {
-    HASHCTL ctl;
+/*
+ * Coerces a value assigned to a strictly typed variable to the stored type.
+ **/
+static Const *
+coerceToStrictType(sessionVariable *variable, Const *value) {
+    Const *old = (Const *) variable->expr;
+    Node *expr;
 
-    Assert(CurrentSession != NULL);
+    if (old->consttype == value->consttype)
+        return value;
 
-    ctl.keysize = SESVAR_SIZE;
-    ctl.entrysize = sizeof(sessionVariable);
-    ctl.hcxt = TopMemoryContext;
+    expr = coerce_type(NULL,
+                       (Node *) value,
+                       value->consttype,
+                       old->consttype,
+                       -1,
+                       COERCION_IMPLICIT,
+                       COERCE_IMPLICIT_CAST,
+                       -1);
 
-    CurrentSession->variables = hash_create("Session variables", 16, &ctl,
+    /* Casts other than from UNKNOWN come back as a function call -> run it */
+    if (!IsA(expr, Const))
+        expr = (Node *) evaluate_expr((Expr *) expr, old->consttype,
+                                      -1, old->constcollid);
+
+    return (Const *) expr;
+}
+
+/*
+ * Checks a value that somebody is going to assign to the session variable
+ * later on, see session_variable_flush_hook.
+ *
+ * Coerces the value to the type of a strictly typed variable and checks it
+ * against session_variables_memory_limit, so that those errors are raised by
+ * the assignment itself rather than by the deferred store. The limit check
+ * uses the flat size of the value, the store checks the exact size again.
+ * Returns the value to store, allocated in CurrentMemoryContext if coerced.
+ *
+ * Pending assignments are not flushed, they never change the type nor the
+ * strictness of a variable.
+ **/
+Const *
+prepareSessionVariableValue(char *varname, Const *value) {
+    sessionVariable *variable = NULL;
+    Size current = 0;
+    Size size;
+
+    checkSessionVariableAssignment();
+
+    if (CurrentSession != NULL && CurrentSession->variables != NULL)
+        variable = (sessionVariable *) hash_search(CurrentSession->variables, varname, HASH_FIND, NULL);
+
+    if (variable != NULL && variable->expr != NULL) {
+        if (variable->strict_type)
+            value = coerceToStrictType(variable, value);
+        current = variable->size;
+    }
+
+    if (value->constbyval || value->constisnull)
+        return value;
+
+    size = sessionVariableDatumSize(value);
+
+    if (session_variables_memory_limit >= 0 && size > current &&
+        sessionVariablesMemory - current + size > (Size) session_variables_memory_limit * 1024)
+        reportSessionVariableMemory(varname, sessionVariablesMemory - current + size);
+
+    return value;
+}
+
+void
+saveSessionVariable(sessionVariable *result, Node *expr, bool exists, SessionVariableSubscripts *subscripts, bool new_strict_type) {
+    Node * newExpr;
+    Size size;
+
+    Assert(result);
+
+    if(subscripts != NULL) {
+        handleArrayIndirection(result, expr, subscripts);
+        return;
+    }
+    
+    if (exists) {
+        /* Invalidate cached plans if we are changing data type */
+        if (((Const *) result->expr)->consttype != ((Const *) expr)->consttype)
+            InvalidateSesvarCache(result->key);
+
+        if(new_strict_type)
+            result->strict_type = true;
+        
+        if (!new_strict_type && result->strict_type)
+            expr = (Node *) coerceToStrictType(result, (Const *) expr);
+    }
+
+    /*
+     * By-value (or NULL) values replacing a by-value one simply overwrite the
+     * stored Const, those are never pinned.
+     **/
+    if (exists && (((Const *) expr)->constbyval || ((Const *) expr)->constisnull) &&
+        GetMemoryChunkContext(result->expr) == SessionVariablesContext) {
+        Assert(result->pin == NULL);
+
+        *((Const *) result->expr) = *((Const *) expr);
+        return;
+    }
+
+    newExpr = (Node *) copySessionVariableValue((Const *) expr, result->key);
+    size = checkSessionVariableMemory(result, (Const *) newExpr);
+
+    /* Free the old value (or leave it to its readers) once we have the new one */
+    if (exists)
+        releaseSessionVariableValue(result);
+
+    result->expr = newExpr;
+    result->size = size;
+    sessionVariablesMemory += size;
+}
+
+void
+initSessionVariables() {
+    HASHCTL ctl;
+
+    Assert(CurrentSession != NULL);
+
+    if (SessionVariablesContext == NULL)
+        SessionVariablesContext = AllocSetContextCreate(TopMemoryContext,
+                                                        "Session variables",
+                                                        ALLOCSET_DEFAULT_SIZES);
+
+    ctl.keysize = SESVAR_SIZE;
+    ctl.entrysize = sizeof(sessionVariable);
+    ctl.hcxt = SessionVariablesContext;
+
+    CurrentSession->variables = hash_create("Session variables", 16, &ctl,
                                             HASH_ELEM | HASH_CONTEXT | HASH_STRINGS);
+    sessionVariablesMemory = 0;
+
+    /* Slots cached against a previous table must not be trusted anymore */
+    sessionVariablesGeneration++;
 
     Assert(CurrentSession->variables != NULL);
 }
 
-void setSessionVariable(char *varname, Node *expr, List *indirection, bool new_strict_type) {
+/*
+ * Finds or creates the hash table slot of the given session variable.
+ * Newly created slots have no value yet (expr == NULL).
+ **/
+static sessionVariable *
+enterSessionVariable(char *varname, bool new_strict_type, bool *found) {
     sessionVariable *ref;
-    bool found;
+
+    FlushPendingSessionVariables();
 
     if (CurrentSession == NULL)
         elog(ERROR, "Session components are not initialized!");
@@ -319,13 +966,1097 @@ void setSessionVariable(char *varname, Node *expr, List *indirection, bool new_s
     if (CurrentSession->variables == NULL)
         initSessionVariables();
 
-    ref = (sessionVariable *) hash_search(CurrentSession->variables, varname, HASH_ENTER_NULL, &found);
+    ref = (sessionVariable *) hash_search(CurrentSession->variables, varname, HASH_ENTER_NULL, found);
 
     if (ref == NULL)
         elog(ERROR, "Could not allocate space for session variable");
 
-    if(!found)
+    if (!*found) {
         ref->strict_type = new_strict_type;
-    
-    saveSessionVariable(ref, expr, found, indirection, new_strict_type);
-}
\ No newline at end of file
+        ref->expr = NULL;
+        ref->pin = NULL;
+        ref->version = 0;
+        ref->checked = 0;
+        ref->shared = NULL;
+        ref->published = 0;
+        ref->reads = 0;
+        ref->writes = 0;
+        ref->size = 0;
+    } else if (ref->expr == NULL) {
+        /* Slot left behind by a failed first assignment */
+        *found = false;
+    }
+
+    return ref;
+}
+
+/*
+ * Parallel workers only get a read-only copy of the session variables the
+ * query reads (see SerializeSessionVariables), assignments must never reach
+ * them as they would be lost with the worker.
+ **/
+static void
+checkSessionVariableAssignment(void) {
+    if (IsParallelWorker())
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_TRANSACTION_STATE),
+                 errmsg("cannot assign session variables during a parallel operation")));
+}
+
+void setSessionVariable(char *varname, Node *expr, SessionVariableSubscripts *subscripts, bool new_strict_type) {
+    sessionVariable *ref;
+    bool found;
+
+    checkSessionVariableAssignment();
+
+    pgSesVarUsage.sesvar_writes++;
+
+    if (IsGlobalVariableName(varname)) {
+        assignGlobalVariable(varname, expr, subscripts, new_strict_type);
+        return;
+    }
+
+    ref = enterSessionVariable(varname, new_strict_type, &found);
+
+    saveSessionVariable(ref, expr, found, subscripts, new_strict_type);
+    ref->writes++;
+}
+
+/*
+ * Builds an unresolved reference to the given session variable.
+ * The slot is resolved lazily by lookupSessionVariable.
+ **/
+SessionVariableRef *
+makeSessionVariableRef(char *name) {
+    SessionVariableRef *ref = (SessionVariableRef *) palloc(sizeof(SessionVariableRef));
+
+    ref->name = name;
+    ref->variable = NULL;
+    ref->generation = 0;
+    ref->castmethod = SESVAR_CAST_NONE;
+    ref->castsource = InvalidOid;
+    ref->casttarget = InvalidOid;
+    ref->castcontext = NULL;
+
+    return ref;
+}
+
+/*
+ * Returns the slot of the session variable the reference points to,
+ * or NULL if the variable does not exist (yet).
+ *
+ * Slots of the session variable table never move, so once found the slot
+ * is cached in the reference and reused until the table generation changes.
+ **/
+sessionVariable *
+lookupSessionVariable(SessionVariableRef *ref) {
+    sessionVariable *variable;
+
+    FlushPendingSessionVariables();
+
+    if (ref->variable != NULL && ref->generation == sessionVariablesGeneration) {
+        /* Local copies of global variables are refreshed in place */
+        if (IsGlobalVariableName(ref->name))
+            return syncGlobalVariable(ref->name, ref->variable);
+
+        return ref->variable;
+    }
+
+    variable = findSessionVariable(ref->name);
+
+    if (!variable)
+        return NULL;
+
+    ref->variable = variable;
+    ref->generation = sessionVariablesGeneration;
+
+    return variable;
+}
+
+/*
+ * Same as setSessionVariable but resolves the variable through
+ * a SessionVariableRef, which avoids hashing the name on repeated calls.
+ **/
+void setSessionVariableRef(SessionVariableRef *ref, Node *expr, SessionVariableSubscripts *subscripts, bool new_strict_type) {
+    sessionVariable *variable;
+    bool found = true;
+
+    checkSessionVariableAssignment();
+
+    pgSesVarUsage.sesvar_writes++;
+
+    if (IsGlobalVariableName(ref->name)) {
+        assignGlobalVariable(ref->name, expr, subscripts, new_strict_type);
+        return;
+    }
+
+    variable = lookupSessionVariable(ref);
+
+    /* First assignment -> the slot gets cached by the next lookup */
+    if (!variable)
+        variable = enterSessionVariable(ref->name, new_strict_type, &found);
+
+    saveSessionVariable(variable, expr, found, subscripts, new_strict_type);
+    variable->writes++;
+}
+
+/*
+ * Executes a simple SET @var := expr [, ...] statement (see
+ * transformSetSessionVariableStmt) without planning it.
+ *
+ * The assignments are evaluated in order as plain expressions, each
+ * SesVarExpr stores its value when evaluated, so later assignments see
+ * the values of the earlier ones just like in the planned statement.
+ **/
+void
+ExecuteSetSessionVariableStmt(SetSessionVariableStmt *stmt, ParamListInfo params) {
+    EState *estate;
+    ExprContext *econtext;
+    ListCell *lc;
+
+    estate = CreateExecutorState();
+    estate->es_param_list_info = params;
+    econtext = GetPerTupleExprContext(estate);
+
+    foreach (lc, stmt->targetList) {
+        TargetEntry *tle = lfirst_node(TargetEntry, lc);
+        ExprState *exprstate;
+        bool isnull;
+
+        exprstate = ExecPrepareExpr(tle->expr, estate);
+        (void) ExecEvalExprSwitchContext(exprstate, econtext, &isnull);
+
+        ResetExprContext(econtext);
+    }
+
+    FreeExecutorState(estate);
+}
+
+/*
+ * Estimate the amount of space required to serialize the value of a single
+ * session variable, see serializeSessionVariableValue.
+ **/
+static Size
+estimateSessionVariableValue(sessionVariable *variable) {
+    Const *con = (Const *) variable->expr;
+    Size sz;
+
+    sz = sizeof(Oid) + sizeof(int32) + sizeof(Oid);
+    sz = add_size(sz, sizeof(int16) + sizeof(bool) + sizeof(bool));
+    sz = add_size(sz, datumEstimateSpace(con->constvalue, con->constisnull,
+                                         con->constbyval, con->constlen));
+
+    return sz;
+}
+
+/*
+ * Serialize the value of a session variable together with its type,
+ * start_address is advanced past the written data.
+ **/
+static void
+serializeSessionVariableValue(sessionVariable *variable, char **start_address) {
+    Const *con = (Const *) variable->expr;
+
+    memcpy(*start_address, &con->consttype, sizeof(Oid));
+    *start_address += sizeof(Oid);
+    memcpy(*start_address, &con->consttypmod, sizeof(int32));
+    *start_address += sizeof(int32);
+    memcpy(*start_address, &con->constcollid, sizeof(Oid));
+    *start_address += sizeof(Oid);
+    memcpy(*start_address, &con->constlen, sizeof(int16));
+    *start_address += sizeof(int16);
+    memcpy(*start_address, &con->constbyval, sizeof(bool));
+    *start_address += sizeof(bool);
+    memcpy(*start_address, &variable->strict_type, sizeof(bool));
+    *start_address += sizeof(bool);
+
+    datumSerialize(con->constvalue, con->constisnull, con->constbyval, con->constlen,
+                   start_address);
+}
+
+/*
+ * Restore a value serialized by serializeSessionVariableValue as a Const
+ * allocated in CurrentMemoryContext.
+ **/
+static Const *
+restoreSessionVariableValue(char **start_address, bool *strict_type) {
+    Oid type;
+    int32 typmod;
+    Oid collid;
+    int16 typlen;
+    bool typbyval;
+    bool isnull;
+    Datum value;
+
+    memcpy(&type, *start_address, sizeof(Oid));
+    *start_address += sizeof(Oid);
+    memcpy(&typmod, *start_address, sizeof(int32));
+    *start_address += sizeof(int32);
+    memcpy(&collid, *start_address, sizeof(Oid));
+    *start_address += sizeof(Oid);
+    memcpy(&typlen, *start_address, sizeof(int16));
+    *start_address += sizeof(int16);
+    memcpy(&typbyval, *start_address, sizeof(bool));
+    *start_address += sizeof(bool);
+    memcpy(strict_type, *start_address, sizeof(bool));
+    *start_address += sizeof(bool);
+
+    value = datumRestore(start_address, &isnull);
+
+    return (Const *) makeConstSessionVariable(type, typmod, collid, typbyval, typlen, isnull, value);
+}
+
+/*
+ * Estimate the amount of space required to serialize the session variables
+ * of the given names (a List of String nodes), see SerializeSessionVariables.
+ **/
+Size
+EstimateSessionVariablesSpace(List *names) {
+    Size sz = sizeof(int);
+    ListCell *lc;
+
+    foreach (lc, names) {
+        char *name = strVal(lfirst(lc));
+        sessionVariable *variable;
+
+        /* Nonexistent variables are not sent, reading them fails anyway */
+        variable = findSessionVariable(name);
+        if (!variable)
+            continue;
+
+        sz = add_size(sz, strlen(name) + 1);
+        sz = add_size(sz, estimateSessionVariableValue(variable));
+    }
+
+    return sz;
+}
+
+/*
+ * Serialize the values of the given session variables into a chunk of
+ * memory, so that parallel workers can read them (RestoreSessionVariables).
+ *
+ * start_address is advanced past the written data, the space must have been
+ * allocated according to EstimateSessionVariablesSpace.
+ **/
+void
+SerializeSessionVariables(List *names, char **start_address) {
+    char *countAddress = *start_address;
+    int count = 0;
+    ListCell *lc;
+
+    *start_address += sizeof(int);
+
+    foreach (lc, names) {
+        char *name = strVal(lfirst(lc));
+        sessionVariable *variable;
+        Size len;
+
+        if (CurrentSession == NULL || CurrentSession->variables == NULL)
+            break;
+
+        /*
+         * Look at the local table only, global variables were brought up to
+         * date by EstimateSessionVariablesSpace already and must not change
+         * size in between.
+         */
+        variable = (sessionVariable *) hash_search(CurrentSession->variables, name, HASH_FIND, NULL);
+        if (!variable || !variable->expr)
+            continue;
+
+        len = strlen(name) + 1;
+        memcpy(*start_address, name, len);
+        *start_address += len;
+
+        serializeSessionVariableValue(variable, start_address);
+        count++;
+    }
+
+    memcpy(countAddress, &count, sizeof(int));
+}
+
+/*
+ * Restore session variables serialized by SerializeSessionVariables
+ * into the session of the current (parallel worker) process.
+ **/
+void
+RestoreSessionVariables(char **start_address) {
+    int count;
+
+    memcpy(&count, *start_address, sizeof(int));
+    *start_address += sizeof(int);
+
+    for (int i = 0; i < count; i++) {
+        char *name = *start_address;
+        bool strict_type;
+        Const *value;
+        sessionVariable *variable;
+        bool found;
+
+        *start_address += strlen(name) + 1;
+
+        value = restoreSessionVariableValue(start_address, &strict_type);
+
+        variable = enterSessionVariable(name, strict_type, &found);
+        saveSessionVariable(variable, (Node *) value, found, NULL, false);
+    }
+}
+
+/* Identifies the format of pg_session_variables_snapshot results */
+#define SESSION_VARIABLES_SNAPSHOT_MAGIC 0x53565331
+
+/*
+ * Returns the names of all session variables of the current session that
+ * have a value, global variables are not part of the session.
+ **/
+static List *
+listSessionVariableNames(void) {
+    HASH_SEQ_STATUS status;
+    sessionVariable *variable;
+    List *names = NIL;
+
+    if (CurrentSession == NULL || CurrentSession->variables == NULL)
+        return NIL;
+
+    hash_seq_init(&status, CurrentSession->variables);
+    while ((variable = (sessionVariable *) hash_seq_search(&status)) != NULL) {
+        if (variable->expr != NULL && !IsGlobalVariableName(variable->key))
+            names = lappend(names, makeString(variable->key));
+    }
+
+    return names;
+}
+
+/*
+ * pg_session_variables_snapshot
+ *
+ * Returns all session variables of the current session as a single bytea,
+ * laid out like the data sent to parallel workers (SerializeSessionVariables)
+ * behind a magic number.
+ **/
+Datum
+pg_session_variables_snapshot(PG_FUNCTION_ARGS) {
+    uint32 magic = SESSION_VARIABLES_SNAPSHOT_MAGIC;
+    List *names;
+    Size size;
+    bytea *result;
+    char *start;
+
+    FlushPendingSessionVariables();
+
+    names = listSessionVariableNames();
+
+    size = add_size(VARHDRSZ + sizeof(uint32), EstimateSessionVariablesSpace(names));
+    if (size > MaxAllocSize)
+        ereport(ERROR,
+                (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                 errmsg("session variables are too large for a snapshot")));
+
+    result = (bytea *) palloc(size);
+    start = VARDATA(result);
+
+    memcpy(start, &magic, sizeof(uint32));
+    start += sizeof(uint32);
+
+    SerializeSessionVariables(names, &start);
+
+    SET_VARSIZE(result, start - (char *) result);
+
+    PG_RETURN_BYTEA_P(result);
+}
+
+/*
+ * Raises an error unless len more bytes of the snapshot are available.
+ **/
+static void
+checkSnapshotSpace(char *start, char *end, Size len) {
+    if (len > (Size) (end - start))
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                 errmsg("invalid session variable snapshot")));
+}
+
+/*
+ * Reads one value of a snapshot, see serializeSessionVariableValue.
+ *
+ * The snapshot comes from the user, so the value must fit into it and agree
+ * with the catalog definition of its type before it is trusted.
+ **/
+static Const *
+readSnapshotValue(char **start_address, char *end, bool *strict_type) {
+    Size fixed = sizeof(Oid) + sizeof(int32) + sizeof(Oid) + sizeof(int16) + sizeof(bool) + sizeof(bool);
+    char *data = *start_address + fixed + sizeof(int);
+    int header;
+    int16 typlen;
+    bool typbyval;
+    Const *con;
+
+    bool valid;
+
+    /* The data header of datumSerialize: -2 = NULL, -1 = by value, else length */
+    checkSnapshotSpace(*start_address, end, fixed + sizeof(int));
+    memcpy(&header, *start_address + fixed, sizeof(int));
+
+    if (header == -1)
+        checkSnapshotSpace(data, end, sizeof(Datum));
+    else if (header > 0)
+        checkSnapshotSpace(data, end, header);
+    else if (header != -2)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                 errmsg("invalid session variable snapshot")));
+
+    con = restoreSessionVariableValue(start_address, strict_type);
+
+    if (!SearchSysCacheExists1(TYPEOID, ObjectIdGetDatum(con->consttype)))
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                 errmsg("invalid session variable snapshot"),
+                 errdetail("Type with OID %u does not exist.", con->consttype)));
+
+    get_typlenbyval(con->consttype, &typlen, &typbyval);
+
+    valid = con->constlen == typlen && con->constbyval == typbyval;
+
+    if (valid && !con->constisnull) {
+        if (typbyval)
+            valid = header == -1;
+        else if (header < 0)
+            valid = false;
+        else if (typlen > 0)
+            valid = header == typlen;
+        else if (typlen == -1)
+            valid = (VARATT_IS_1B(data) || header >= VARHDRSZ) &&
+                    !VARATT_IS_EXTERNAL(data) && VARSIZE_ANY(data) == header;
+        else
+            valid = data[header - 1] == '\0' && strlen(data) + 1 == header;
+    }
+
+    if (!valid)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                 errmsg("invalid session variable snapshot")));
+
+    return con;
+}
+
+/*
+ * pg_session_variables_restore
+ *
+ * Replaces all session variables of the current session by the ones of
+ * a snapshot taken by pg_session_variables_snapshot, returns their number.
+ *
+ * The whole snapshot is checked and copied, and the memory the session
+ * variables will use afterwards checked against
+ * session_variables_memory_limit, before any variable is touched. So an
+ * invalid or too large snapshot leaves the session as it was.
+ **/
+Datum
+pg_session_variables_restore(PG_FUNCTION_ARGS) {
+    bytea *snapshot = PG_GETARG_BYTEA_PP(0);
+    char *start = VARDATA_ANY(snapshot);
+    char *end = start + VARSIZE_ANY_EXHDR(snapshot);
+    List *names = NIL;
+    List *values = NIL;
+    List *stricts = NIL;
+    List *copies = NIL;
+    HASH_SEQ_STATUS status;
+    sessionVariable *variable;
+    ListCell *lcn, *lcv, *lcs;
+    uint32 magic;
+    int count;
+    Size total;
+
+    checkSessionVariableAssignment();
+
+    checkSnapshotSpace(start, end, sizeof(uint32) + sizeof(int));
+    memcpy(&magic, start, sizeof(uint32));
+    start += sizeof(uint32);
+    memcpy(&count, start, sizeof(int));
+    start += sizeof(int);
+
+    if (magic != SESSION_VARIABLES_SNAPSHOT_MAGIC || count < 0)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                 errmsg("invalid session variable snapshot")));
+
+    for (int i = 0; i < count; i++) {
+        char *name = start;
+        Size len = strnlen(name, Min(end - start, SESVAR_SIZE));
+        bool strict_type;
+
+        if (len == (Size) (end - start) || len >= SESVAR_SIZE ||
+            name[0] != '@' || IsGlobalVariableName(name))
+            ereport(ERROR,
+                    (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                     errmsg("invalid session variable snapshot")));
+        start += len + 1;
+
+        values = lappend(values, readSnapshotValue(&start, end, &strict_type));
+        names = lappend(names, name);
+        stricts = lappend_int(stricts, strict_type);
+    }
+
+    if (start != end)
+        ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                 errmsg("invalid session variable snapshot")));
+
+    FlushPendingSessionVariables();
+
+    /* Memory held once the session variables are replaced by the snapshot */
+    total = sessionVariablesMemory;
+
+    if (CurrentSession != NULL && CurrentSession->variables != NULL) {
+        hash_seq_init(&status, CurrentSession->variables);
+        while ((variable = (sessionVariable *) hash_seq_search(&status)) != NULL) {
+            if (!IsGlobalVariableName(variable->key))
+                total -= variable->size;
+        }
+    }
+
+    forboth (lcn, names, lcv, values) {
+        Const *copy = copySessionVariableValue((Const *) lfirst(lcv), (char *) lfirst(lcn));
+
+        copies = lappend(copies, copy);
+        total += sessionVariableValueSize(copy);
+    }
+
+    if (session_variables_memory_limit >= 0 && total > sessionVariablesMemory &&
+        total > (Size) session_variables_memory_limit * 1024) {
+        foreach (lcv, copies)
+            freeSessionVariableValue((Const *) lfirst(lcv));
+
+        ereport(ERROR,
+                (errcode(ERRCODE_CONFIGURATION_LIMIT_EXCEEDED),
+                 errmsg("session variables memory exceeds session_variables_memory_limit (%dkB)",
+                        session_variables_memory_limit),
+                 errdetail("Restoring the snapshot would use %zu bytes in total.", total)));
+    }
+
+    /* Drop the variables the snapshot does not know about */
+    if (CurrentSession != NULL && CurrentSession->variables != NULL) {
+        hash_seq_init(&status, CurrentSession->variables);
+        while ((variable = (sessionVariable *) hash_seq_search(&status)) != NULL) {
+            char key[SESVAR_SIZE];
+            bool keep = false;
+            ListCell *lc;
+
+            if (IsGlobalVariableName(variable->key))
+                continue;
+
+            foreach (lc, names) {
+                if (strcmp((char *) lfirst(lc), variable->key) == 0) {
+                    keep = true;
+                    break;
+                }
+            }
+
+            if (keep)
+                continue;
+
+            strlcpy(key, variable->key, SESVAR_SIZE);
+
+            if (variable->expr != NULL) {
+                InvalidateSesvarCache(key);
+                releaseSessionVariableValue(variable);
+            }
+
+            hash_search(CurrentSession->variables, key, HASH_REMOVE, NULL);
+
+            /* Removed slots may still be cached in SessionVariableRef */
+            sessionVariablesGeneration++;
+        }
+    }
+
+    /* The copies are installed as they were, strict types do not interfere */
+    forthree (lcn, names, lcv, copies, lcs, stricts) {
+        Const *copy = (Const *) lfirst(lcv);
+        bool found;
+
+        variable = enterSessionVariable((char *) lfirst(lcn), false, &found);
+
+        if (found) {
+            if (((Const *) variable->expr)->consttype != copy->consttype)
+                InvalidateSesvarCache(variable->key);
+
+            releaseSessionVariableValue(variable);
+        }
+
+        variable->expr = (Node *) copy;
+        variable->size = sessionVariableValueSize(copy);
+        variable->strict_type = (bool) lfirst_int(lcs);
+        sessionVariablesMemory += variable->size;
+    }
+
+    PG_RETURN_INT32(count);
+}
+
+/*
+ * pg_stat_get_session_variables
+ *
+ * Returns the size and access counts of each session variable of the
+ * current session, global variables show up once read by the session.
+ **/
+Datum
+pg_stat_get_session_variables(PG_FUNCTION_ARGS) {
+#define PG_STAT_GET_SESSION_VARIABLES_COLS 5
+    ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+    HASH_SEQ_STATUS status;
+    sessionVariable *variable;
+
+    InitMaterializedSRF(fcinfo, 0);
+
+    FlushPendingSessionVariables();
+
+    if (CurrentSession == NULL || CurrentSession->variables == NULL)
+        return (Datum) 0;
+
+    hash_seq_init(&status, CurrentSession->variables);
+    while ((variable = (sessionVariable *) hash_seq_search(&status)) != NULL) {
+        Datum values[PG_STAT_GET_SESSION_VARIABLES_COLS] = {0};
+        bool nulls[PG_STAT_GET_SESSION_VARIABLES_COLS] = {0};
+        Const *con = (Const *) variable->expr;
+
+        if (con == NULL)
+            continue;
+
+        values[0] = CStringGetTextDatum(variable->key);
+        values[1] = ObjectIdGetDatum(con->consttype);
+        if (con->constisnull)
+            nulls[2] = true;
+        else
+            values[2] = Int64GetDatum((int64) sessionVariableDatumSize(con));
+        values[3] = Int64GetDatum(variable->reads);
+        values[4] = Int64GetDatum(variable->writes);
+
+        tuplestore_putvalues(rsinfo->setResult, rsinfo->setDesc, values, nulls);
+    }
+
+    return (Datum) 0;
+}
+
+Size
+GlobalVariablesShmemSize(void) {
+    Size size = offsetof(GlobalVariablesCtxStruct, hazards);
+
+    size = add_size(size, mul_size(NumGlobalVariableHazards, sizeof(dsa_pointer_atomic)));
+
+    return MAXALIGN(size);
+}
+
+void
+GlobalVariablesShmemInit(void) {
+    bool found;
+
+    GlobalVariablesCtx = (GlobalVariablesCtxStruct *)
+        ShmemInitStruct("Global Variables Data",
+                        GlobalVariablesShmemSize(),
+                        &found);
+
+    if (!found) {
+        GlobalVariablesCtx->dsah = DSA_HANDLE_INVALID;
+        GlobalVariablesCtx->dshh = DSHASH_HANDLE_INVALID;
+        /* Local copies start with checked = 0, which is never current */
+        pg_atomic_init_u64(&GlobalVariablesCtx->generation, 1);
+        pg_atomic_init_u64(&GlobalVariablesCtx->memory, 0);
+        GlobalVariablesCtx->retired = InvalidDsaPointer;
+
+        for (int i = 0; i < NumGlobalVariableHazards; i++)
+            dsa_pointer_atomic_init(&GlobalVariablesCtx->hazards[i], InvalidDsaPointer);
+    }
+}
+
+/*
+ * Creates or attaches the shared hash table of global variables,
+ * the table is only set up once the first global variable is used.
+ **/
+static void
+initGlobalVariables(void) {
+    MemoryContext oldContext;
+
+    if (globalVariablesTable)
+        return;
+
+    /* The mappings have to outlive the current query */
+    oldContext = MemoryContextSwitchTo(TopMemoryContext);
+
+    LWLockAcquire(GlobalVariablesLock, LW_EXCLUSIVE);
+
+    if (GlobalVariablesCtx->dshh == DSHASH_HANDLE_INVALID) {
+        globalVariablesArea = dsa_create(LWTRANCHE_GLOBAL_VARIABLES_DSA);
+        dsa_pin(globalVariablesArea);
+        dsa_pin_mapping(globalVariablesArea);
+        globalVariablesTable = dshash_create(globalVariablesArea, &globalVariablesParams, NULL);
+
+        GlobalVariablesCtx->dsah = dsa_get_handle(globalVariablesArea);
+        GlobalVariablesCtx->dshh = dshash_get_hash_table_handle(globalVariablesTable);
+    } else {
+        globalVariablesArea = dsa_attach(GlobalVariablesCtx->dsah);
+        dsa_pin_mapping(globalVariablesArea);
+        globalVariablesTable = dshash_attach(globalVariablesArea, &globalVariablesParams,
+                                             GlobalVariablesCtx->dshh, NULL);
+    }
+
+    LWLockRelease(GlobalVariablesLock);
+
+    MemoryContextSwitchTo(oldContext);
+}
+
+/*
+ * Returns the shared entry of a global variable, or NULL if it was never
+ * assigned.  Entries are never removed nor moved, so the entry found is
+ * remembered in the local slot and the shared hash table is only searched
+ * (and locked) the first time.
+ **/
+static GlobalVariableEntry *
+findGlobalVariableEntry(char *name, sessionVariable *variable) {
+    GlobalVariableEntry *entry;
+
+    if (variable != NULL && variable->shared != NULL)
+        return variable->shared;
+
+    entry = (GlobalVariableEntry *) dshash_find(globalVariablesTable, name, false);
+
+    if (entry == NULL)
+        return NULL;
+
+    dshash_release_lock(globalVariablesTable, entry);
+
+    if (variable != NULL)
+        variable->shared = entry;
+
+    return entry;
+}
+
+/*
+ * Returns the current version of the entry, announced in the hazard slot
+ * of the backend so that it is not freed until releaseGlobalVariableValue.
+ *
+ * The version is announced first and checked to be still current after,
+ * an assignment swapping it meanwhile either sees the announcement when
+ * retiring it, or gets noticed here by the reader, which then retries.
+ **/
+static dsa_pointer
+acquireGlobalVariableValue(GlobalVariableEntry *entry) {
+    dsa_pointer_atomic *hazard = &GlobalVariablesCtx->hazards[MyProcNumber];
+    dsa_pointer value;
+
+    for (;;) {
+        value = dsa_pointer_atomic_read(&entry->value);
+
+        if (!DsaPointerIsValid(value))
+            return value;
+
+        dsa_pointer_atomic_write(hazard, value);
+        pg_memory_barrier();
+
+        if (dsa_pointer_atomic_read(&entry->value) == value)
+            return value;
+    }
+}
+
+static void
+releaseGlobalVariableValue(void) {
+    /* Reads of the version must be done before it can be freed */
+    pg_memory_barrier();
+    dsa_pointer_atomic_write(&GlobalVariablesCtx->hazards[MyProcNumber], InvalidDsaPointer);
+}
+
+static void
+freeGlobalVariableValue(dsa_pointer value) {
+    GlobalVariableValue *shared = dsa_get_address(globalVariablesArea, value);
+
+    pg_atomic_sub_fetch_u64(&GlobalVariablesCtx->memory, shared->size);
+    dsa_free(globalVariablesArea, value);
+}
+
+static bool
+isGlobalVariableValueRead(dsa_pointer value) {
+    for (int i = 0; i < NumGlobalVariableHazards; i++) {
+        if (dsa_pointer_atomic_read(&GlobalVariablesCtx->hazards[i]) == value)
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Retires a version replaced by an assignment, it is freed right away unless
+ * someone is still copying it.  Versions retired earlier are given another
+ * chance on the way, so that the list only holds versions being read.
+ **/
+static void
+retireGlobalVariableValue(dsa_pointer value) {
+    GlobalVariableValue *shared = dsa_get_address(globalVariablesArea, value);
+    dsa_pointer *prev;
+
+    LWLockAcquire(GlobalVariablesLock, LW_EXCLUSIVE);
+
+    shared->next = GlobalVariablesCtx->retired;
+    GlobalVariablesCtx->retired = value;
+
+    /* The version was swapped out before, see acquireGlobalVariableValue */
+    pg_memory_barrier();
+
+    prev = &GlobalVariablesCtx->retired;
+
+    while (DsaPointerIsValid(*prev)) {
+        value = *prev;
+        shared = dsa_get_address(globalVariablesArea, value);
+
+        if (isGlobalVariableValueRead(value)) {
+            prev = &shared->next;
+            continue;
+        }
+
+        *prev = shared->next;
+        freeGlobalVariableValue(value);
+    }
+
+    LWLockRelease(GlobalVariablesLock);
+}
+
+/*
+ * Makes sure the local copy of a global variable is up to date and returns
+ * its slot, or the given one if the variable has not been assigned yet.
+ *
+ * As long as no global variable is assigned anywhere, this is just a read of
+ * the shared generation.  Otherwise the current version of the entry is
+ * copied if it is newer than the local copy, without taking any lock.
+ * The copy is saved as if assigned by the owner of the variable, so a
+ * locally strict type does not get in the way of the new value.  Slots never
+ * move, so the refresh does not invalidate any SessionVariableRef.
+ **/
+static sessionVariable *
+syncGlobalVariable(char *name, sessionVariable *variable) {
+    GlobalVariableEntry *entry;
+    GlobalVariableValue *shared;
+    dsa_pointer value;
+    uint64 generation;
+    uint64 version;
+    Size published;
+    bool strict_type;
+    bool exists = true;
+    Const *con;
+    char *start;
+
+    /* Parallel workers stick to the values sent by the leader */
+    if (IsParallelWorker())
+        return variable;
+
+    initGlobalVariables();
+
+    /*
+     * Read before the entry, assignments bump the generation only once the
+     * new version is published, so a concurrent one is not missed.
+     **/
+    generation = pg_atomic_read_membarrier_u64(&GlobalVariablesCtx->generation);
+
+    if (variable != NULL && variable->checked == generation)
+        return variable;
+
+    entry = findGlobalVariableEntry(name, variable);
+
+    if (entry == NULL)
+        return variable;
+
+    value = acquireGlobalVariableValue(entry);
+
+    if (!DsaPointerIsValid(value))
+        return variable;
+
+    /*
+     * Copy out first, the version must not be held while saving the copy.
+     * The hazard slot is cleared on errors too, or the version would stay
+     * retired and count against global_variables_memory_limit for good.
+     **/
+    PG_TRY();
+    {
+        shared = dsa_get_address(globalVariablesArea, value);
+        version = shared->version;
+        published = shared->size;
+
+        if (variable != NULL && variable->expr != NULL && variable->version == version)
+            con = NULL;
+        else {
+            start = GlobalVariableValueData(shared);
+            con = restoreSessionVariableValue(&start, &strict_type);
+        }
+    }
+    PG_FINALLY();
+    {
+        releaseGlobalVariableValue();
+    }
+    PG_END_TRY();
+
+    /* The local copy is of that version already */
+    if (con == NULL) {
+        variable->checked = generation;
+        return variable;
+    }
+
+    if (variable == NULL)
+        variable = enterSessionVariable(name, strict_type, &exists);
+    else
+        exists = variable->expr != NULL;
+
+    variable->strict_type = false;
+    saveSessionVariable(variable, (Node *) con, exists, NULL, false);
+    variable->strict_type = strict_type;
+    variable->version = version;
+    variable->published = published;
+    variable->shared = entry;
+    variable->checked = generation;
+
+    if (!con->constbyval && !con->constisnull)
+        pfree(DatumGetPointer(con->constvalue));
+    pfree(con);
+
+    return variable;
+}
+
+/*
+ * Global variables are shared by all roles, assigning them is reserved to
+ * the members of pg_write_global_variables.
+ **/
+static void
+checkGlobalVariablePrivileges(char *varname) {
+    if (!has_privs_of_role(GetUserId(), ROLE_PG_WRITE_GLOBAL_VARIABLES))
+        ereport(ERROR,
+                (errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+                 errmsg("permission denied to assign global variable \"%s\"", varname),
+                 errdetail("Only roles with privileges of the \"%s\" role may assign global variables.",
+                           "pg_write_global_variables")));
+}
+
+/*
+ * Accounts for a new version of the given size against
+ * global_variables_memory_limit.  Versions not larger than the one they
+ * replace are always accepted, so that a variable can be shrunk even above
+ * the limit.
+ **/
+static void
+reserveGlobalVariableMemory(char *varname, Size size, Size replaced) {
+    uint64 total = pg_atomic_add_fetch_u64(&GlobalVariablesCtx->memory, size);
+
+    if (global_variables_memory_limit >= 0 && size > replaced &&
+        total > (uint64) global_variables_memory_limit * 1024) {
+        pg_atomic_sub_fetch_u64(&GlobalVariablesCtx->memory, size);
+        ereport(ERROR,
+                (errcode(ERRCODE_CONFIGURATION_LIMIT_EXCEEDED),
+                 errmsg("global variables memory exceeds global_variables_memory_limit (%dkB)",
+                        global_variables_memory_limit),
+                 errdetail("Assigning global variable \"%s\" would use %llu bytes in total.",
+                           varname, (unsigned long long) total)));
+    }
+}
+
+/*
+ * Assigns a global variable: the assignment is done on the local copy
+ * (brought up to date first) and its value is then published as the new
+ * version of the shared entry.
+ *
+ * Everything that may take a while (coercion, subscripting, serialization)
+ * is done without holding any lock.  The entry is locked only to check that
+ * the version the assignment started from is still the current one and to
+ * swap in the new version, otherwise the assignment starts over from the
+ * newer version, so that concurrent assignments do not get lost.
+ **/
+static void
+assignGlobalVariable(char *varname, Node *expr, SessionVariableSubscripts *subscripts, bool new_strict_type) {
+    GlobalVariableEntry *entry;
+    GlobalVariableValue *shared;
+    sessionVariable *variable;
+    dsa_pointer value;
+    dsa_pointer current;
+    uint64 base;
+    uint64 version;
+    Size size;
+    char *start;
+    bool found;
+
+    checkGlobalVariablePrivileges(varname);
+
+    /* Deferred assignments could end up here again, run them first */
+    FlushPendingSessionVariables();
+
+    initGlobalVariables();
+
+    entry = (GlobalVariableEntry *) dshash_find_or_insert(globalVariablesTable, varname, &found);
+
+    if (!found)
+        dsa_pointer_atomic_init(&entry->value, InvalidDsaPointer);
+
+    dshash_release_lock(globalVariablesTable, entry);
+
+    for (;;) {
+        CHECK_FOR_INTERRUPTS();
+
+        variable = enterSessionVariable(varname, new_strict_type, &found);
+        variable->shared = entry;
+        variable->checked = 0;
+        variable = syncGlobalVariable(varname, variable);
+        found = variable->expr != NULL;
+        base = variable->version;
+
+        /* Until published, the local copy must not pass for the shared one */
+        variable->version = 0;
+        variable->checked = 0;
+
+        saveSessionVariable(variable, expr, found, subscripts, new_strict_type);
+
+        size = add_size(MAXALIGN(sizeof(GlobalVariableValue)), estimateSessionVariableValue(variable));
+        reserveGlobalVariableMemory(varname, size, variable->published);
+
+        value = dsa_allocate_extended(globalVariablesArea, size, DSA_ALLOC_HUGE | DSA_ALLOC_NO_OOM);
+
+        if (!DsaPointerIsValid(value)) {
+            pg_atomic_sub_fetch_u64(&GlobalVariablesCtx->memory, size);
+            ereport(ERROR,
+                    (errcode(ERRCODE_OUT_OF_MEMORY),
+                     errmsg("out of memory"),
+                     errdetail("Failed on request of size %zu in global variable \"%s\".",
+                               size, varname)));
+        }
+
+        shared = dsa_get_address(globalVariablesArea, value);
+        shared->version = base + 1;
+        shared->size = size;
+        shared->next = InvalidDsaPointer;
+        start = GlobalVariableValueData(shared);
+        serializeSessionVariableValue(variable, &start);
+
+        /* Nothing but the swap itself is done while the entry is locked */
+        entry = (GlobalVariableEntry *) dshash_find(globalVariablesTable, varname, true);
+        Assert(entry != NULL);
+
+        current = dsa_pointer_atomic_read(&entry->value);
+        version = 0;
+
+        if (DsaPointerIsValid(current))
+            version = ((GlobalVariableValue *) dsa_get_address(globalVariablesArea, current))->version;
+
+        if (version == base) {
+            /* Readers must see the whole version once they see the pointer */
+            pg_write_barrier();
+            dsa_pointer_atomic_write(&entry->value, value);
+        }
+
+        dshash_release_lock(globalVariablesTable, entry);
+
+        if (version == base)
+            break;
+
+        /* Lost the race to a concurrent assignment, start over from its version */
+        freeGlobalVariableValue(value);
+    }
+
+    pg_atomic_fetch_add_u64(&GlobalVariablesCtx->generation, 1);
+
+    variable->version = base + 1;
+    variable->published = size;
+    variable->writes++;
+
+    if (DsaPointerIsValid(current))
+        retireGlobalVariableValue(current);
+}
@@ -34,6 +34,7 @@
 #include "catalog/objectaccess.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
+#include "commands/sessionvariable.h"
 #include "executor/execExpr.h"
 #include "executor/nodeSubplan.h"
 #include "funcapi.h"
@@ -1021,7 +1022,7 @@ ExecInitExprRec(Expr *node, ExprState *state,
 						break;
                     case PARAM_SESSION_VARIABLE:
                         scratch.opcode = EEOP_PARAM_SESVAR;
-                        scratch.d.sesvar.sesvarid = param->paramsesvarid;
+                        scratch.d.sesvar.sesvarref = makeSessionVariableRef(param->paramsesvarid);
                         scratch.d.sesvar.sesvartype = param->paramtype;
                         ExprEvalPushStep(state, &scratch);
                         break;
@@ -1172,11 +1173,30 @@ ExecInitExprRec(Expr *node, ExprState *state,
                 SesVarExpr *sesvar = (SesVarExpr *) node;
 
                 scratch.opcode = EEOP_SESVAREXPR;
-                scratch.d.sesvar.sesvarid = sesvar->name;
+                scratch.d.sesvar.sesvarref = makeSessionVariableRef(sesvar->name);
                 scratch.d.sesvar.sesvartype = sesvar->resulttype;
                 scratch.d.sesvar.sesvarcollid = sesvar->collid;
-                scratch.d.sesvar.sesvarindirection = sesvar->indirection;
+                scratch.d.sesvar.sesvarsubscripts = NULL;
                 scratch.d.sesvar.sesvarstricttype = sesvar->strict_type;
+                get_typlenbyval(sesvar->resulttype,
+                                &scratch.d.sesvar.sesvartyplen,
+                                &scratch.d.sesvar.sesvartypbyval);
+
+                /* Evaluate array subscripts into the step's private storage */
+                if (sesvar->upperindex) {
+                    SesVarSubscriptState *sbsstate = palloc0(sizeof(SesVarSubscriptState));
+
+                    sbsstate->isslice = sesvar->lowerindex != NULL;
+                    ExecInitExprRec(sesvar->upperindex, state,
+                                    &sbsstate->upperindex,
+                                    &sbsstate->upperindexnull);
+                    if (sbsstate->isslice)
+                        ExecInitExprRec(sesvar->lowerindex, state,
+                                        &sbsstate->lowerindex,
+                                        &sbsstate->lowerindexnull);
+
+                    scratch.d.sesvar.sesvarsubscripts = sbsstate;
+                }
                 
                 ExecInitExprRec((Expr *) sesvar->arg, state,
                                 resv,
@@ -1104,58 +1104,15 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 
         EEO_CASE(EEOP_SESVAREXPR)
         {
-            Datum arg_value;
-            bool arg_isnull;
-            Oid typeOid;
-            int16 typLen;
-            bool typByVal;
-
-            /* Arg was evaluated in previous step */
-            ExprEvalStep *hold = op - 1;
-            arg_value = *hold->resvalue;
-            arg_isnull = *hold->resnull;
-            
-            /* Get necessarily data for saving variable */
-            typeOid = op->d.sesvar.sesvartype;
-            get_typlenbyval(typeOid, &typLen, &typByVal);
-            
-            /* Set the new value to session variable */
-            setSessionVariable(op->d.sesvar.sesvarid,
-                               makeConstSessionVariable(typeOid,
-                                                        -1,
-                                                        op->d.sesvar.sesvarcollid,
-                                                        typByVal,
-                                                        typLen,
-                                                        arg_isnull,
-                                                        arg_value), op->d.sesvar.sesvarindirection,
-                                                                    op->d.sesvar.sesvarstricttype);
-            
-            /* Output value */
-            *op->resvalue = arg_value;
-            *op->resnull = arg_isnull;
-            
+            /* out of line implementation, shared with JIT */
+            ExecEvalSesVarExpr(state, op, econtext);
             EEO_NEXT();
         }
         
         EEO_CASE(EEOP_PARAM_SESVAR)
         {
-            /*
-             * op->d.sesvar.sesvartype Contains type requested by the query
-             * The value itself can be save with unknownoid and just
-             * here we try to match it to the requested type oid
-             **/
-            Const *con = getConstSessionVariable(op->d.sesvar.sesvarid, op->d.sesvar.sesvartype);
-            
-            if(!con) {
-                elog(ERROR, "session variable \"%s\" does not exist", op->d.sesvar.sesvarid);
-            } else if(con->constisnull == false) {
-                *op->resvalue = datumCopy(con->constvalue, con->constbyval, con->constlen);
-                *op->resnull = false;
-            } else {
-                *op->resvalue = (Datum) 0;
-                *op->resnull = true;
-            }
-            
+            /* out of line implementation, shared with JIT */
+            ExecEvalParamSesvar(state, op, econtext);
             EEO_NEXT();
         }
 
@@ -2753,6 +2710,60 @@ ExecEvalParamSet(ExprState *state, ExprEvalStep *op, ExprContext *econtext)
 	prm->isnull = state->resnull;
 }
 
+/*
+ * Assign a value to a session variable (EEOP_SESVAREXPR).
+ *
+ * The value to assign was evaluated into op's result variable, which is also
+ * the result of the assignment.  Array subscripts (if any) were evaluated into
+ * op->d.sesvar.sesvarsubscripts by the preceding steps.
+ */
+void
+ExecEvalSesVarExpr(ExprState *state, ExprEvalStep *op, ExprContext *econtext)
+{
+    SesVarSubscriptState *sbsstate = op->d.sesvar.sesvarsubscripts;
+    SessionVariableSubscripts subscripts;
+
+    if (sbsstate) {
+        if (sbsstate->upperindexnull ||
+            (sbsstate->isslice && sbsstate->lowerindexnull))
+            ereport(ERROR,
+                    (errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+                     errmsg("array subscript in assignment must not be null")));
+
+        subscripts.upper = DatumGetInt32(sbsstate->upperindex);
+        subscripts.lower = sbsstate->isslice ? DatumGetInt32(sbsstate->lowerindex) :
+                                               subscripts.upper;
+    }
+
+    setSessionVariableRef(op->d.sesvar.sesvarref,
+                          makeConstSessionVariable(op->d.sesvar.sesvartype,
+                                                   -1,
+                                                   op->d.sesvar.sesvarcollid,
+                                                   op->d.sesvar.sesvartypbyval,
+                                                   op->d.sesvar.sesvartyplen,
+                                                   *op->resnull,
+                                                   *op->resvalue),
+                          sbsstate ? &subscripts : NULL,
+                          op->d.sesvar.sesvarstricttype);
+}
+
+/*
+ * Read the value of a session variable (EEOP_PARAM_SESVAR).
+ *
+ * op->d.sesvar.sesvartype contains the type requested by the query, the value
+ * itself may be stored with a different type and is coerced to it here.
+ *
+ * The value is not copied, by-reference values stay pinned until the current
+ * (per-tuple) memory context is reset.
+ */
+void
+ExecEvalParamSesvar(ExprState *state, ExprEvalStep *op, ExprContext *econtext)
+{
+    if (!readSessionVariableRef(op->d.sesvar.sesvarref, op->d.sesvar.sesvartype,
+                                op->resvalue, op->resnull))
+        elog(ERROR, "session variable \"%s\" does not exist", op->d.sesvar.sesvarref->name);
+}
+
 /*
  * Evaluate a CoerceViaIO node in soft-error mode.
  *
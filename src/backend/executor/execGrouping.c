@@ -354,6 +354,18 @@ TupleHashTableHash(TupleHashTable hashtable, TupleTableSlot *slot)
 	return hash;
 }
 
+/*
+ * Prefetch the bucket a tuple with the given hash value would be looked up in,
+ * for callers that compute hash values ahead of LookupTupleHashEntryHash().
+ */
+void
+PrefetchTupleHashEntry(TupleHashTable hashtable, uint32 hash)
+{
+	tuplehash_hash *tb = hashtable->hashtab;
+
+	pg_prefetch_mem(&tb->data[hash & tb->sizemask]);
+}
+
 /*
  * A variant of LookupTupleHashEntry for callers that have already computed
  * the hash value.
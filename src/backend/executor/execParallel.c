@@ -23,6 +23,7 @@
 
 #include "postgres.h"
 
+#include "commands/sessionvariable.h"
 #include "executor/execParallel.h"
 #include "executor/executor.h"
 #include "executor/nodeAgg.h"
@@ -64,6 +65,7 @@
 #define PARALLEL_KEY_QUERY_TEXT		UINT64CONST(0xE000000000000008)
 #define PARALLEL_KEY_JIT_INSTRUMENTATION UINT64CONST(0xE000000000000009)
 #define PARALLEL_KEY_WAL_USAGE			UINT64CONST(0xE00000000000000A)
+#define PARALLEL_KEY_SESSION_VARIABLES	UINT64CONST(0xE00000000000000B)
 
 #define PARALLEL_TUPLE_QUEUE_SIZE		65536
 
@@ -602,6 +604,8 @@ ExecInitParallelPlan(PlanState *planstate, EState *estate,
 	SharedJitInstrumentation *jit_instrumentation = NULL;
 	int			pstmt_len;
 	int			paramlistinfo_len;
+	Size		sesvars_len;
+	char	   *sesvars_space;
 	int			instrumentation_len = 0;
 	int			jit_instrumentation_len = 0;
 	int			instrument_offset = 0;
@@ -660,6 +664,12 @@ ExecInitParallelPlan(PlanState *planstate, EState *estate,
 	shm_toc_estimate_chunk(&pcxt->estimator, paramlistinfo_len);
 	shm_toc_estimate_keys(&pcxt->estimator, 1);
 
+	/* Estimate space for values of the session variables read by the plan. */
+	sesvars_len =
+		EstimateSessionVariablesSpace(estate->es_plannedstmt->sessionVariables);
+	shm_toc_estimate_chunk(&pcxt->estimator, sesvars_len);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
 	/*
 	 * Estimate space for BufferUsage.
 	 *
@@ -761,6 +771,12 @@ ExecInitParallelPlan(PlanState *planstate, EState *estate,
 	shm_toc_insert(pcxt->toc, PARALLEL_KEY_PARAMLISTINFO, paramlistinfo_space);
 	SerializeParamList(estate->es_param_list_info, &paramlistinfo_space);
 
+	/* Store values of the session variables read by the plan. */
+	sesvars_space = shm_toc_allocate(pcxt->toc, sesvars_len);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_SESSION_VARIABLES, sesvars_space);
+	SerializeSessionVariables(estate->es_plannedstmt->sessionVariables,
+							  &sesvars_space);
+
 	/* Allocate space for each worker's BufferUsage; no need to initialize. */
 	bufusage_space = shm_toc_allocate(pcxt->toc,
 									  mul_size(sizeof(BufferUsage), pcxt->nworkers));
@@ -1241,6 +1257,7 @@ ExecParallelGetQueryDesc(shm_toc *toc, DestReceiver *receiver,
 {
 	char	   *pstmtspace;
 	char	   *paramspace;
+	char	   *sesvarspace;
 	PlannedStmt *pstmt;
 	ParamListInfo paramLI;
 	char	   *queryString;
@@ -1256,6 +1273,10 @@ ExecParallelGetQueryDesc(shm_toc *toc, DestReceiver *receiver,
 	paramspace = shm_toc_lookup(toc, PARALLEL_KEY_PARAMLISTINFO, false);
 	paramLI = RestoreParamList(&paramspace);
 
+	/* Restore the session variables the plan reads. */
+	sesvarspace = shm_toc_lookup(toc, PARALLEL_KEY_SESSION_VARIABLES, false);
+	RestoreSessionVariables(&sesvarspace);
+
 	/* Create a QueryDesc for the query. */
 	return CreateQueryDesc(pstmt,
 						   queryString,
@@ -496,6 +496,52 @@ ExecProcNodeInstr(PlanState *node)
 }
 
 
+/* ----------------------------------------------------------------
+ *		ExecProcNodeBatch
+ *
+ *		Execute the given node to return up to maxslots tuples at once.
+ *
+ * The tuples are handed out in slots[], which stay valid until the next
+ * call for the node; the number of tuples is returned, 0 meaning that no
+ * more tuples are available.  Nodes without a batch mode return a single
+ * tuple per call, so this can be used with any child node.
+ * ----------------------------------------------------------------
+ */
+int
+ExecProcNodeBatch(PlanState *node, TupleTableSlot **slots, int maxslots)
+{
+	int			nslots;
+
+	Assert(maxslots > 0 && maxslots <= EXEC_BATCH_SIZE);
+
+	if (node->ExecProcNodeBatch == NULL)
+	{
+		TupleTableSlot *slot = ExecProcNode(node);
+
+		if (TupIsNull(slot))
+			return 0;
+
+		slots[0] = slot;
+		return 1;
+	}
+
+	check_stack_depth();
+
+	if (node->chgParam != NULL) /* something changed */
+		ExecReScan(node);		/* let ReScan handle this */
+
+	if (node->instrument)
+		InstrStartNode(node->instrument);
+
+	nslots = node->ExecProcNodeBatch(node, slots, maxslots);
+
+	if (node->instrument)
+		InstrStopNode(node->instrument, nslots);
+
+	return nslots;
+}
+
+
 /* ----------------------------------------------------------------
  *		MultiExecProcNode
  *
@@ -253,6 +253,60 @@ ExecScan(ScanState *node,
 	}
 }
 
+/* ----------------------------------------------------------------
+ *		ExecScanBatch
+ *
+ *		Batch mode counterpart of ExecScan.  Fetches tuples from the
+ *		access method into batchslots[], one slot per tuple, until
+ *		maxslots of them passed the qual or the scan is exhausted.
+ *		The qualifying slots are returned in slots[] and their number
+ *		as the result.
+ *
+ *		Only usable for nodes without a projection and outside of
+ *		EvalPlanQual, which the caller has to check at node init.
+ * ----------------------------------------------------------------
+ */
+int
+ExecScanBatch(ScanState *node,
+			  ExecScanBatchAccessMtd accessMtd, /* function filling a slot */
+			  TupleTableSlot **batchslots,
+			  TupleTableSlot **slots,
+			  int maxslots)
+{
+	ExprContext *econtext = node->ps.ps_ExprContext;
+	ExprState  *qual = node->ps.qual;
+	int			nslots = 0;
+
+	Assert(node->ps.ps_ProjInfo == NULL);
+	Assert(node->ps.state->es_epq_active == NULL);
+
+	while (nslots < maxslots)
+	{
+		TupleTableSlot *slot = batchslots[nslots];
+
+		CHECK_FOR_INTERRUPTS();
+
+		if (!accessMtd(node, slot))
+			break;
+
+		if (qual != NULL)
+		{
+			ResetExprContext(econtext);
+			econtext->ecxt_scantuple = slot;
+
+			if (!ExecQual(qual, econtext))
+			{
+				InstrCountFiltered1(node, 1);
+				continue;
+			}
+		}
+
+		slots[nslots++] = slot;
+	}
+
+	return nslots;
+}
+
 /*
  * ExecAssignScanProjectionInfo
  *		Set up projection info for a scan node, if necessary.
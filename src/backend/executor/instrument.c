@@ -21,9 +21,12 @@ BufferUsage pgBufferUsage;
 static BufferUsage save_pgBufferUsage;
 WalUsage	pgWalUsage;
 static WalUsage save_pgWalUsage;
+SessionVariableUsage pgSesVarUsage;
 
 static void BufferUsageAdd(BufferUsage *dst, const BufferUsage *add);
 static void WalUsageAdd(WalUsage *dst, WalUsage *add);
+static void SessionVariableUsageAdd(SessionVariableUsage *dst,
+									const SessionVariableUsage *add);
 
 
 /* Allocate new instrumentation structure(s) */
@@ -34,10 +37,12 @@ InstrAlloc(int n, int instrument_options, bool async_mode)
 
 	/* initialize all fields to zeroes, then modify as needed */
 	instr = palloc0(n * sizeof(Instrumentation));
-	if (instrument_options & (INSTRUMENT_BUFFERS | INSTRUMENT_TIMER | INSTRUMENT_WAL))
+	if (instrument_options & (INSTRUMENT_BUFFERS | INSTRUMENT_TIMER | INSTRUMENT_WAL |
+							  INSTRUMENT_SESVARS))
 	{
 		bool		need_buffers = (instrument_options & INSTRUMENT_BUFFERS) != 0;
 		bool		need_wal = (instrument_options & INSTRUMENT_WAL) != 0;
+		bool		need_sesvars = (instrument_options & INSTRUMENT_SESVARS) != 0;
 		bool		need_timer = (instrument_options & INSTRUMENT_TIMER) != 0;
 		int			i;
 
@@ -45,6 +50,7 @@ InstrAlloc(int n, int instrument_options, bool async_mode)
 		{
 			instr[i].need_bufusage = need_buffers;
 			instr[i].need_walusage = need_wal;
+			instr[i].need_sesvarusage = need_sesvars;
 			instr[i].need_timer = need_timer;
 			instr[i].async_mode = async_mode;
 		}
@@ -60,6 +66,7 @@ InstrInit(Instrumentation *instr, int instrument_options)
 	memset(instr, 0, sizeof(Instrumentation));
 	instr->need_bufusage = (instrument_options & INSTRUMENT_BUFFERS) != 0;
 	instr->need_walusage = (instrument_options & INSTRUMENT_WAL) != 0;
+	instr->need_sesvarusage = (instrument_options & INSTRUMENT_SESVARS) != 0;
 	instr->need_timer = (instrument_options & INSTRUMENT_TIMER) != 0;
 }
 
@@ -77,6 +84,9 @@ InstrStartNode(Instrumentation *instr)
 
 	if (instr->need_walusage)
 		instr->walusage_start = pgWalUsage;
+
+	if (instr->need_sesvarusage)
+		instr->sesvarusage_start = pgSesVarUsage;
 }
 
 /* Exit from a plan node */
@@ -110,6 +120,10 @@ InstrStopNode(Instrumentation *instr, double nTuples)
 		WalUsageAccumDiff(&instr->walusage,
 						  &pgWalUsage, &instr->walusage_start);
 
+	if (instr->need_sesvarusage)
+		SessionVariableUsageAccumDiff(&instr->sesvarusage,
+									  &pgSesVarUsage, &instr->sesvarusage_start);
+
 	/* Is this the first tuple of this cycle? */
 	if (!instr->running)
 	{
@@ -193,6 +207,9 @@ InstrAggNode(Instrumentation *dst, Instrumentation *add)
 
 	if (dst->need_walusage)
 		WalUsageAdd(&dst->walusage, &add->walusage);
+
+	if (dst->need_sesvarusage)
+		SessionVariableUsageAdd(&dst->sesvarusage, &add->sesvarusage);
 }
 
 /* note current values during parallel executor startup */
@@ -289,3 +306,27 @@ WalUsageAccumDiff(WalUsage *dst, const WalUsage *add, const WalUsage *sub)
 	dst->wal_records += add->wal_records - sub->wal_records;
 	dst->wal_fpi += add->wal_fpi - sub->wal_fpi;
 }
+
+/* helper functions for session variable usage accumulation */
+static void
+SessionVariableUsageAdd(SessionVariableUsage *dst,
+						const SessionVariableUsage *add)
+{
+	dst->sesvar_reads += add->sesvar_reads;
+	dst->sesvar_writes += add->sesvar_writes;
+	dst->sesvar_coercions += add->sesvar_coercions;
+	dst->sesvar_bytes += add->sesvar_bytes;
+	dst->sesvar_invalidations += add->sesvar_invalidations;
+}
+
+void
+SessionVariableUsageAccumDiff(SessionVariableUsage *dst,
+							  const SessionVariableUsage *add,
+							  const SessionVariableUsage *sub)
+{
+	dst->sesvar_reads += add->sesvar_reads - sub->sesvar_reads;
+	dst->sesvar_writes += add->sesvar_writes - sub->sesvar_writes;
+	dst->sesvar_coercions += add->sesvar_coercions - sub->sesvar_coercions;
+	dst->sesvar_bytes += add->sesvar_bytes - sub->sesvar_bytes;
+	dst->sesvar_invalidations += add->sesvar_invalidations - sub->sesvar_invalidations;
+}
@@ -367,6 +367,7 @@ typedef struct FindColsContext
 static void select_current_set(AggState *aggstate, int setno, bool is_hash);
 static void initialize_phase(AggState *aggstate, int newphase);
 static TupleTableSlot *fetch_input_tuple(AggState *aggstate);
+static void prefetch_input_batch(AggState *aggstate);
 static void initialize_aggregates(AggState *aggstate,
 								  AggStatePerGroup *pergroups,
 								  int numReset);
@@ -557,6 +558,27 @@ fetch_input_tuple(AggState *aggstate)
 			return NULL;
 		slot = aggstate->sort_slot;
 	}
+	else if (aggstate->input_batch)
+	{
+		if (aggstate->input_batch_next >= aggstate->input_batch_count)
+		{
+			aggstate->input_batch_count =
+				ExecProcNodeBatch(outerPlanState(aggstate),
+								  aggstate->input_batch, EXEC_BATCH_SIZE);
+			aggstate->input_batch_next = 0;
+			if (aggstate->input_batch_count == 0)
+				return NULL;
+			if (aggstate->input_batch_hash)
+				prefetch_input_batch(aggstate);
+		}
+		if (aggstate->input_batch_hash &&
+			aggstate->input_batch_next + hash_prefetch_depth <
+			aggstate->input_batch_count)
+			PrefetchTupleHashEntry(aggstate->perhash[0].hashtable,
+								   aggstate->input_batch_hash[aggstate->input_batch_next +
+															  hash_prefetch_depth]);
+		slot = aggstate->input_batch[aggstate->input_batch_next++];
+	}
 	else
 		slot = ExecProcNode(outerPlanState(aggstate));
 
@@ -566,6 +588,33 @@ fetch_input_tuple(AggState *aggstate)
 	return slot;
 }
 
+/*
+ * Compute the hash values of a freshly fetched input batch, and prefetch the
+ * hash table buckets of its first hash_prefetch_depth tuples.  The buckets of
+ * the others are prefetched by fetch_input_tuple() as it walks the batch, so
+ * that they are hopefully in the CPU cache once lookup_hash_entries() gets to
+ * them.
+ */
+static void
+prefetch_input_batch(AggState *aggstate)
+{
+	AggStatePerHash perhash = &aggstate->perhash[0];
+
+	Assert(aggstate->num_hashes == 1);
+
+	for (int i = 0; i < aggstate->input_batch_count; i++)
+	{
+		uint32		hash;
+
+		prepare_hash_slot(perhash, aggstate->input_batch[i], perhash->hashslot);
+		hash = TupleHashTableHash(perhash->hashtable, perhash->hashslot);
+		aggstate->input_batch_hash[i] = hash;
+
+		if (i < hash_prefetch_depth)
+			PrefetchTupleHashEntry(perhash->hashtable, hash);
+	}
+}
+
 /*
  * (Re)Initialize an individual aggregate.
  *
@@ -2116,8 +2165,16 @@ lookup_hash_entries(AggState *aggstate)
 						  outerslot,
 						  hashslot);
 
-		entry = LookupTupleHashEntry(hashtable, hashslot,
-									 p_isnew, &hash);
+		/* use the hash value computed by prefetch_input_batch(), if any */
+		if (aggstate->input_batch_hash != NULL)
+		{
+			hash = aggstate->input_batch_hash[aggstate->input_batch_next - 1];
+			entry = LookupTupleHashEntryHash(hashtable, hashslot,
+											 p_isnew, hash);
+		}
+		else
+			entry = LookupTupleHashEntry(hashtable, hashslot,
+										 p_isnew, &hash);
 
 		if (entry != NULL)
 		{
@@ -3304,6 +3361,13 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	outerPlan = outerPlan(node);
 	outerPlanState(aggstate) = ExecInitNode(outerPlan, estate, eflags);
 
+	/*
+	 * Fetch input tuples in batches if the child node supports it.
+	 */
+	if (outerPlanState(aggstate)->ExecProcNodeBatch != NULL)
+		aggstate->input_batch =
+			palloc(sizeof(TupleTableSlot *) * EXEC_BATCH_SIZE);
+
 	/*
 	 * initialize source tuple type.
 	 */
@@ -3620,6 +3684,15 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 
 		aggstate->table_filled = false;
 
+		/*
+		 * With input fetched in batches, hash the tuples of each batch ahead
+		 * of their lookups so that their buckets can be prefetched.
+		 */
+		if (aggstate->input_batch != NULL && hash_prefetch_depth > 0 &&
+			node->aggstrategy == AGG_HASHED && aggstate->num_hashes == 1)
+			aggstate->input_batch_hash =
+				palloc(sizeof(uint32) * EXEC_BATCH_SIZE);
+
 		/* Initialize this to 1, meaning nothing spilled, yet */
 		aggstate->hash_batches_used = 1;
 	}
@@ -4436,6 +4509,10 @@ ExecReScanAgg(AggState *node)
 	}
 	ExecClearTuple(node->ss.ss_ScanTupleSlot);
 
+	/* Forget any input tuples left over from the last batch */
+	node->input_batch_count = 0;
+	node->input_batch_next = 0;
+
 	/* Forget current agg values */
 	MemSet(econtext->ecxt_aggvalues, 0, sizeof(Datum) * node->numaggs);
 	MemSet(econtext->ecxt_aggnulls, 0, sizeof(bool) * node->numaggs);
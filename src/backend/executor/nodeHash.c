@@ -34,6 +34,7 @@
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "lib/bloomfilter.h"
 #include "miscadmin.h"
 #include "port/pg_bitutils.h"
 #include "utils/dynahash.h"
@@ -44,6 +45,7 @@
 
 static void ExecHashIncreaseNumBatches(HashJoinTable hashtable);
 static void ExecHashIncreaseNumBuckets(HashJoinTable hashtable);
+static void ExecHashFreeBloomFilter(HashJoinTable hashtable);
 static void ExecParallelHashIncreaseNumBatches(HashJoinTable hashtable);
 static void ExecParallelHashIncreaseNumBuckets(HashJoinTable hashtable);
 static void ExecHashBuildSkewHash(HashState *hashstate,
@@ -178,6 +180,11 @@ MultiExecPrivateHash(HashState *node)
 			uint32		hashvalue = DatumGetUInt32(hashdatum);
 			int			bucketNumber;
 
+			if (hashtable->bloomFilter != NULL)
+				bloom_add_element(hashtable->bloomFilter,
+								  (unsigned char *) &hashvalue,
+								  sizeof(hashvalue));
+
 			bucketNumber = ExecHashGetSkewBucket(hashtable, hashvalue);
 			if (bucketNumber != INVALID_SKEW_BUCKET_NO)
 			{
@@ -199,6 +206,15 @@ MultiExecPrivateHash(HashState *node)
 	if (hashtable->nbuckets != hashtable->nbuckets_optimal)
 		ExecHashIncreaseNumBuckets(hashtable);
 
+	/*
+	 * A Bloom filter with most of its bits set would let nearly every outer
+	 * tuple through (the inner row estimate it was sized for was far off),
+	 * so don't bother checking outer tuples against it.
+	 */
+	if (hashtable->bloomFilter != NULL &&
+		bloom_prop_bits_set(hashtable->bloomFilter) > BLOOM_FILTER_MAX_BITS_SET)
+		ExecHashFreeBloomFilter(hashtable);
+
 	/* Account for the buckets in spaceUsed (reported in EXPLAIN ANALYZE) */
 	hashtable->spaceUsed += hashtable->nbuckets * sizeof(HashJoinTuple);
 	if (hashtable->spaceUsed > hashtable->spacePeak)
@@ -512,6 +528,10 @@ ExecHashTableCreate(HashState *state)
 	hashtable->skewTuples = 0;
 	hashtable->innerBatchFile = NULL;
 	hashtable->outerBatchFile = NULL;
+	hashtable->bloomFilter = NULL;
+	hashtable->bloomSpace = 0;
+	hashtable->bloomChecked = 0;
+	hashtable->bloomRejected = 0;
 	hashtable->spaceUsed = 0;
 	hashtable->spacePeak = 0;
 	hashtable->spaceAllowed = space_allowed;
@@ -890,6 +910,94 @@ ExecHashTableDestroy(HashJoinTable hashtable)
 	pfree(hashtable);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecHashBuildBloomFilter
+ *
+ *		set up a Bloom filter over the hash values of the inner tuples
+ *
+ * Must be called before the hash table is filled.  An outer tuple whose
+ * hash value the filter lacks cannot have a match, so a join that discards
+ * unmatched outer tuples can drop it right away instead of writing it out
+ * to a batch file and reading it back later.  ntuples is the expected
+ * number of inner tuples.
+ * ----------------------------------------------------------------
+ */
+void
+ExecHashBuildBloomFilter(HashJoinTable hashtable, double ntuples)
+{
+	MemoryContext oldcxt;
+
+	Assert(hashtable->parallel_state == NULL);
+	Assert(hashtable->bloomFilter == NULL);
+
+	/*
+	 * Spend at most a quarter of the hash table's memory budget on it.  That
+	 * is often well below the 1MB bloom_create starts at, the filter is
+	 * sized here to stay within the budget.  Its memory counts against the
+	 * budget like that of the inner tuples.
+	 */
+	oldcxt = MemoryContextSwitchTo(hashtable->hashCxt);
+	hashtable->bloomFilter = bloom_create_bounded((int64) Max(ntuples, 1.0),
+												  hashtable->spaceAllowed / 4,
+												  0);
+	MemoryContextSwitchTo(oldcxt);
+
+	hashtable->bloomSpace = GetMemoryChunkSpace(hashtable->bloomFilter);
+	hashtable->spaceUsed += hashtable->bloomSpace;
+	if (hashtable->spaceUsed > hashtable->spacePeak)
+		hashtable->spacePeak = hashtable->spaceUsed;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecHashFreeBloomFilter
+ *
+ *		drop the Bloom filter and give its memory back to the budget
+ *
+ * bloomSpace is kept, for EXPLAIN ANALYZE to report the size of the filter.
+ * ----------------------------------------------------------------
+ */
+static void
+ExecHashFreeBloomFilter(HashJoinTable hashtable)
+{
+	Assert(hashtable->bloomFilter != NULL);
+
+	bloom_free(hashtable->bloomFilter);
+	hashtable->bloomFilter = NULL;
+	hashtable->spaceUsed -= hashtable->bloomSpace;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecHashBloomFilterRejects
+ *
+ *		check an outer tuple's hash value against the Bloom filter
+ *
+ * Returns true if the outer tuple cannot have a match.  Once enough outer
+ * tuples have been checked, a filter that rejects too few of them to pay
+ * for itself is dropped.
+ * ----------------------------------------------------------------
+ */
+bool
+ExecHashBloomFilterRejects(HashJoinTable hashtable, uint32 hashvalue)
+{
+	Assert(hashtable->bloomFilter != NULL);
+
+	hashtable->bloomChecked += 1;
+
+	if (bloom_lacks_element(hashtable->bloomFilter,
+							(unsigned char *) &hashvalue, sizeof(hashvalue)))
+	{
+		hashtable->bloomRejected += 1;
+		return true;
+	}
+
+	if (hashtable->bloomChecked >= BLOOM_FILTER_SAMPLE_TUPLES &&
+		hashtable->bloomRejected <
+		hashtable->bloomChecked * BLOOM_FILTER_MIN_REJECTED)
+		ExecHashFreeBloomFilter(hashtable);
+
+	return false;
+}
+
 /*
  * ExecHashIncreaseNumBatches
  *		increase the original number of batches in order to reduce
@@ -2194,6 +2302,13 @@ ExecHashTableReset(HashJoinTable hashtable)
 	MemoryContext oldcxt;
 	int			nbuckets = hashtable->nbuckets;
 
+	/*
+	 * The Bloom filter only serves the first pass over the outer side, the
+	 * outer tuples of later batches were checked before being written out.
+	 */
+	if (hashtable->bloomFilter != NULL)
+		ExecHashFreeBloomFilter(hashtable);
+
 	/*
 	 * Release all the hash buckets and tuples acquired in the prior pass, and
 	 * reinitialize the context for a new pass.
@@ -2752,6 +2867,12 @@ ExecHashAccumInstrumentation(HashInstrumentation *instrument,
 									  hashtable->nbatch_original);
 	instrument->space_peak = Max(instrument->space_peak,
 								 hashtable->spacePeak);
+	instrument->bloom_space = Max(instrument->bloom_space,
+								  hashtable->bloomSpace);
+	instrument->bloom_checked = Max(instrument->bloom_checked,
+									hashtable->bloomChecked);
+	instrument->bloom_rejected = Max(instrument->bloom_rejected,
+									 hashtable->bloomRejected);
 }
 
 /*
@@ -192,6 +192,9 @@
 static TupleTableSlot *ExecHashJoinOuterGetTuple(PlanState *outerNode,
 												 HashJoinState *hjstate,
 												 uint32 *hashvalue);
+static TupleTableSlot *ExecHashJoinOuterGetBatchedTuple(PlanState *outerNode,
+														HashJoinState *hjstate,
+														uint32 *hashvalue);
 static TupleTableSlot *ExecParallelHashJoinOuterGetTuple(PlanState *outerNode,
 														 HashJoinState *hjstate,
 														 uint32 *hashvalue);
@@ -335,6 +338,16 @@ ExecHashJoinImpl(PlanState *pstate, bool parallel)
 				hashtable = ExecHashTableCreate(hashNode);
 				node->hj_HashTable = hashtable;
 
+				/*
+				 * If the join is going to spill to batch files and discards
+				 * unmatched outer tuples, collect the inner hash values in a
+				 * Bloom filter so that outer tuples without a possible match
+				 * are dropped before being written out.
+				 */
+				if (!parallel && !HJ_FILL_OUTER(node) && hashtable->nbatch > 1)
+					ExecHashBuildBloomFilter(hashtable,
+											 outerPlanState(hashNode)->plan->plan_rows);
+
 				/*
 				 * Execute the Hash node, to build the hash table.  If using
 				 * Parallel Hash, then we'll try to help hashing unless we
@@ -935,6 +948,20 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 	hjstate->hj_MatchedOuter = false;
 	hjstate->hj_OuterNotEmpty = false;
 
+	/*
+	 * Fetch outer tuples in batches if that's possible, so that their hash
+	 * buckets can be prefetched.  Parallel-aware joins probe a shared hash
+	 * table and don't do this.
+	 */
+	if (hash_prefetch_depth > 0 && !node->join.plan.parallel_aware &&
+		outerPlanState(hjstate)->ExecProcNodeBatch != NULL)
+	{
+		hjstate->hj_OuterBatch =
+			palloc(sizeof(TupleTableSlot *) * EXEC_BATCH_SIZE);
+		hjstate->hj_OuterBatchHash = palloc(sizeof(uint32) * EXEC_BATCH_SIZE);
+		hjstate->hj_OuterBatchIsNull = palloc(sizeof(bool) * EXEC_BATCH_SIZE);
+	}
+
 	return hjstate;
 }
 
@@ -993,6 +1020,9 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 		slot = hjstate->hj_FirstOuterTupleSlot;
 		if (!TupIsNull(slot))
 			hjstate->hj_FirstOuterTupleSlot = NULL;
+		else if (hjstate->hj_OuterBatch != NULL)
+			return ExecHashJoinOuterGetBatchedTuple(outerNode, hjstate,
+													hashvalue);
 		else
 			slot = ExecProcNode(outerNode);
 
@@ -1018,13 +1048,19 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 				/* remember outer relation is not empty for possible rescan */
 				hjstate->hj_OuterNotEmpty = true;
 
-				return slot;
+				if (hashtable->bloomFilter == NULL ||
+					!ExecHashBloomFilterRejects(hashtable, *hashvalue))
+					return slot;
 			}
 
 			/*
-			 * That tuple couldn't match because of a NULL, so discard it and
-			 * continue with the next one.
+			 * That tuple couldn't match because of a NULL, or because no
+			 * inner tuple has its hash value, so discard it and continue with
+			 * the next one.
 			 */
+			if (hjstate->hj_OuterBatch != NULL)
+				return ExecHashJoinOuterGetBatchedTuple(outerNode, hjstate,
+														hashvalue);
 			slot = ExecProcNode(outerNode);
 		}
 	}
@@ -1051,6 +1087,139 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 	return NULL;
 }
 
+/*
+ * ExecHashJoinOuterBatchBucket
+ *
+ *		return the hash bucket the i'th tuple of hj_OuterBatch will probe, or
+ *		NULL if it won't probe the in-memory hash table.
+ */
+static inline HashJoinTuple *
+ExecHashJoinOuterBatchBucket(HashJoinState *hjstate, int i)
+{
+	HashJoinTable hashtable = hjstate->hj_HashTable;
+	int			bucketno;
+	int			batchno;
+
+	if (hjstate->hj_OuterBatchIsNull[i])
+		return NULL;
+
+	ExecHashGetBucketAndBatch(hashtable, hjstate->hj_OuterBatchHash[i],
+							  &bucketno, &batchno);
+	if (batchno != hashtable->curbatch)
+		return NULL;
+
+	return &hashtable->buckets.unshared[bucketno];
+}
+
+/*
+ * ExecHashJoinPrefetchBucket
+ *
+ *		prefetch the hash bucket the i'th tuple of hj_OuterBatch will probe.
+ */
+static inline void
+ExecHashJoinPrefetchBucket(HashJoinState *hjstate, int i)
+{
+	HashJoinTuple *bucket = ExecHashJoinOuterBatchBucket(hjstate, i);
+
+	if (bucket != NULL)
+		pg_prefetch_mem(bucket);
+}
+
+/*
+ * ExecHashJoinPrefetchBucketHead
+ *
+ *		prefetch the first tuple in the hash bucket the i'th tuple of
+ *		hj_OuterBatch will probe.  The bucket itself was prefetched a few
+ *		tuples earlier, so reading it should no longer miss the cache.
+ */
+static inline void
+ExecHashJoinPrefetchBucketHead(HashJoinState *hjstate, int i)
+{
+	HashJoinTuple *bucket = ExecHashJoinOuterBatchBucket(hjstate, i);
+
+	if (bucket != NULL && *bucket != NULL)
+		pg_prefetch_mem(*bucket);
+}
+
+/*
+ * ExecHashJoinOuterGetBatchedTuple
+ *
+ *		first-pass part of ExecHashJoinOuterGetTuple for an outer plan with a
+ *		batch mode.  The outer tuples are fetched and hashed a batch at a time,
+ *		so that their buckets can be prefetched ahead of the probes.
+ *
+ * Prefetching takes two stages, since the first tuple of a bucket can only
+ * be located once the bucket has been loaded.  The bucket of the tuple
+ * hash_prefetch_depth tuples ahead is prefetched, and the first tuple in the
+ * bucket of the tuple half as far ahead, whose bucket was prefetched earlier.
+ * Both are hopefully in the CPU cache once the tuple is probed.
+ */
+static TupleTableSlot *
+ExecHashJoinOuterGetBatchedTuple(PlanState *outerNode,
+								 HashJoinState *hjstate,
+								 uint32 *hashvalue)
+{
+	HashJoinTable hashtable = hjstate->hj_HashTable;
+	int			head_depth = hash_prefetch_depth / 2;
+	int			i;
+
+	for (;;)
+	{
+		if (hjstate->hj_OuterBatchNext >= hjstate->hj_OuterBatchCount)
+		{
+			ExprContext *econtext = hjstate->js.ps.ps_ExprContext;
+			int			nslots;
+
+			nslots = ExecProcNodeBatch(outerNode, hjstate->hj_OuterBatch,
+									   EXEC_BATCH_SIZE);
+			hjstate->hj_OuterBatchCount = nslots;
+			hjstate->hj_OuterBatchNext = 0;
+			if (nslots == 0)
+				return NULL;
+
+			/* compute the hash values of the whole batch up front */
+			for (i = 0; i < nslots; i++)
+			{
+				bool		isnull;
+
+				econtext->ecxt_outertuple = hjstate->hj_OuterBatch[i];
+				ResetExprContext(econtext);
+				hjstate->hj_OuterBatchHash[i] =
+					DatumGetUInt32(ExecEvalExprSwitchContext(hjstate->hj_OuterHash,
+															 econtext,
+															 &isnull));
+				hjstate->hj_OuterBatchIsNull[i] = isnull;
+			}
+
+			for (i = 0; i < Min(nslots, hash_prefetch_depth); i++)
+				ExecHashJoinPrefetchBucket(hjstate, i);
+			for (i = 0; i < Min(nslots, head_depth); i++)
+				ExecHashJoinPrefetchBucketHead(hjstate, i);
+		}
+
+		i = hjstate->hj_OuterBatchNext++;
+		if (i + hash_prefetch_depth < hjstate->hj_OuterBatchCount)
+			ExecHashJoinPrefetchBucket(hjstate, i + hash_prefetch_depth);
+		if (head_depth > 0 && i + head_depth < hjstate->hj_OuterBatchCount)
+			ExecHashJoinPrefetchBucketHead(hjstate, i + head_depth);
+
+		/*
+		 * As in ExecHashJoinOuterGetTuple, discard tuples that can't match
+		 * because of a NULL or because of the Bloom filter.
+		 */
+		if (!hjstate->hj_OuterBatchIsNull[i])
+		{
+			/* remember outer relation is not empty for possible rescan */
+			hjstate->hj_OuterNotEmpty = true;
+
+			*hashvalue = hjstate->hj_OuterBatchHash[i];
+			if (hashtable->bloomFilter == NULL ||
+				!ExecHashBloomFilterRejects(hashtable, *hashvalue))
+				return hjstate->hj_OuterBatch[i];
+		}
+	}
+}
+
 /*
  * ExecHashJoinOuterGetTuple variant for the parallel case.
  */
@@ -1569,6 +1738,8 @@ ExecReScanHashJoin(HashJoinState *node)
 
 	node->hj_MatchedOuter = false;
 	node->hj_FirstOuterTupleSlot = NULL;
+	node->hj_OuterBatchCount = 0;
+	node->hj_OuterBatchNext = 0;
 
 	/*
 	 * if chgParam of subnode is not null then plan will be re-scanned by
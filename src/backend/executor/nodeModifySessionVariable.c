@@ -59,6 +59,45 @@ typedef struct ModifySessionVariableContext
     TupleTableSlot *planSlot;
 } ModifySessionVariableContext;
 
+/* ----------------------------------------------------------------
+ *		ExecAssignSessionVariableColumns
+ *
+ *		Assigns each column of the row to the session variable it is
+ *		named after (SELECT ... INTO @var), in the order of the columns.
+ * ----------------------------------------------------------------
+ */
+static void
+ExecAssignSessionVariableColumns(ModifySessionVariableState *node, TupleTableSlot *slot)
+{
+    Plan	   *subplan = outerPlan(node->ps.plan);
+    ListCell   *lc;
+
+    slot_getallattrs(slot);
+
+    foreach(lc, subplan->targetlist)
+    {
+        TargetEntry *tle = lfirst_node(TargetEntry, lc);
+        AttrNumber	attno = tle->resno;
+        Oid			typid = exprType((Node *) tle->expr);
+        int16		typlen;
+        bool		typbyval;
+        Node	   *value;
+
+        if (tle->resjunk)
+            continue;
+
+        get_typlenbyval(typid, &typlen, &typbyval);
+
+        value = makeConstSessionVariable(typid, exprTypmod((Node *) tle->expr),
+                                         exprCollation((Node *) tle->expr),
+                                         typbyval, typlen,
+                                         slot->tts_isnull[attno - 1],
+                                         slot->tts_values[attno - 1]);
+
+        setSessionVariable(tle->resname, value, NULL, false);
+    }
+}
+
 /* ----------------------------------------------------------------
  *		ExecSetSessionVariable
  * ----------------------------------------------------------------
@@ -70,7 +109,7 @@ ExecSetSessionVariable(PlanState *pstate)
     ModifySessionVariableContext context;
     EState	   *estate = node->ps.state;
     PlanState  *subplanstate;
-    TupleTableSlot *slot;
+    bool		found = false;
 
     /*
      * If we've already completed processing, don't try to do more.  We need
@@ -94,8 +133,6 @@ ExecSetSessionVariable(PlanState *pstate)
 	 */
     for (int j = 0;;++j)
     {
-        TupleDesc tupleDesc;
-
         /*
          * Reset the per-output-tuple exprcontext.  This is needed because
          * triggers expect to use that context as workspace.  It's a bit ugly
@@ -118,28 +155,22 @@ ExecSetSessionVariable(PlanState *pstate)
         /* No more tuples to process? */
         if (TupIsNull(context.planSlot))
             break;
-        else if(!TupIsNull(context.planSlot) && j != 0)
+        else if(j != 0)
             elog(ERROR, "Can not assign more than 1 row into variable");
 
-        slot = context.planSlot;
-        slot_getallattrs(slot);
-
-        tupleDesc = slot->tts_tupleDescriptor;
-        for (int i = 0; i < tupleDesc->natts; ++i)
+        /* Keep the row until we know it is the only one */
+        if (node->mt_row != NULL)
         {
-            Form_pg_attribute attr = TupleDescAttr(tupleDesc, i);
-
-            /*
-             * Thanks to the code inside grammar and analyze we know that each column should have it's assigned varname
-             * If not it means user had to try and save more then 1 value inside the variable thus making one column nameless
-             **/
-            if(NameStr(attr->attname)[0] != '@')
-                elog(ERROR, "Can not assign more than 1 column into session variable");
+            ExecCopySlot(node->mt_row, context.planSlot);
+            found = true;
         }
     }
 
     node->mt_done = true;
 
+    if (found)
+        ExecAssignSessionVariableColumns(node, node->mt_row);
+
     return NULL;
 }
 
@@ -150,6 +181,7 @@ ExecSetSessionVariable(PlanState *pstate)
 ModifySessionVariableState *ExecInitSetSessionVariable(ModifySessionVariable *node, EState *estate, int eflags){
     ModifySessionVariableState *msvstate;
     Plan	   *subplan = outerPlan(node);
+    ListCell   *lc;
 
     /*
      * create state structure
@@ -159,12 +191,47 @@ ModifySessionVariableState *ExecInitSetSessionVariable(ModifySessionVariable *no
     msvstate->ps.state = estate;
     msvstate->ps.ExecProcNode = ExecSetSessionVariable;
     msvstate->mt_done = false;
+    msvstate->mt_row = NULL;
 
     /*
      * Now we may initialize the subplan.
      */
     outerPlanState(msvstate) = ExecInitNode(subplan, estate, eflags);
 
+    /*
+     * Only the first row gets assigned, a second one is fetched just to report
+     * the error. Let sorts and limits below us know they can stop early.
+     **/
+    ExecSetTupleBound(2, outerPlanState(msvstate));
+
+    /*
+     * SELECT ... INTO @var assigns the row only once the subplan is known
+     * to return no other one, assignments done while the subplan runs would
+     * already have overwritten the variables with the second row.
+     **/
+    if (node->assignColumns)
+        msvstate->mt_row = ExecInitExtraTupleSlot(estate,
+                                                  ExecGetResultType(outerPlanState(msvstate)),
+                                                  &TTSOpsMinimalTuple);
+
+    /*
+     * Thanks to the code inside grammar and analyze we know that each column should have it's assigned varname
+     * If not it means user had to try and save more then 1 value inside the variable thus making one column nameless
+     *
+     * The subplan output does not change between rows so it is enough to check it once here.
+     * Junk columns (sort keys of SELECT ... INTO @var ORDER BY) are never assigned.
+     **/
+    foreach(lc, subplan->targetlist)
+    {
+        TargetEntry *tle = lfirst_node(TargetEntry, lc);
+
+        if (tle->resjunk)
+            continue;
+
+        if(tle->resname == NULL || tle->resname[0] != '@')
+            elog(ERROR, "Can not assign more than 1 column into session variable");
+    }
+
     /*
      * We still must construct a dummy result tuple type, because InitPlan
      * expects one (maybe should change that?).
@@ -34,6 +34,7 @@
 #include "utils/rel.h"
 
 static TupleTableSlot *SeqNext(SeqScanState *node);
+static bool SeqNextBatch(SeqScanState *node, TupleTableSlot *slot);
 
 /* ----------------------------------------------------------------
  *						Scan Support
@@ -82,6 +83,44 @@ SeqNext(SeqScanState *node)
 	return NULL;
 }
 
+/* ----------------------------------------------------------------
+ *		SeqNextBatch
+ *
+ *		Like SeqNext, but fetches the next tuple into the given slot,
+ *		for ExecSeqScanBatch
+ * ----------------------------------------------------------------
+ */
+static bool
+SeqNextBatch(SeqScanState *node, TupleTableSlot *slot)
+{
+	TableScanDesc scandesc = node->ss.ss_currentScanDesc;
+	EState	   *estate = node->ss.ps.state;
+	BufferHeapTupleTableSlot *bslot = (BufferHeapTupleTableSlot *) slot;
+
+	if (scandesc == NULL)
+	{
+		scandesc = table_beginscan(node->ss.ss_currentRelation,
+								   estate->es_snapshot,
+								   0, NULL);
+		node->ss.ss_currentScanDesc = scandesc;
+	}
+
+	if (!table_scan_getnextslot(scandesc, estate->es_direction, slot))
+		return false;
+
+	/*
+	 * The heap scan leaves the slot pointing at the tuple header in the scan
+	 * descriptor, which the next fetch overwrites.  Give the slot a copy of
+	 * its own, so that the slots of one batch stay valid side by side.  The
+	 * slot keeps its own pin on the buffer holding the tuple data.
+	 */
+	Assert(TTS_IS_BUFFERTUPLE(slot));
+	bslot->base.tupdata = *bslot->base.tuple;
+	bslot->base.tuple = &bslot->base.tupdata;
+
+	return true;
+}
+
 /*
  * SeqRecheck -- access method routine to recheck a tuple in EvalPlanQual
  */
@@ -114,6 +153,40 @@ ExecSeqScan(PlanState *pstate)
 					(ExecScanRecheckMtd) SeqRecheck);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecSeqScanBatch(node)
+ *
+ *		Batch mode variant of ExecSeqScan, returning up to maxslots
+ *		qualifying tuples at once.  Each tuple gets a slot of its own,
+ *		so they all stay valid until the next call.
+ * ----------------------------------------------------------------
+ */
+static int
+ExecSeqScanBatch(PlanState *pstate, TupleTableSlot **slots, int maxslots)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+
+	if (node->batch_slots == NULL)
+	{
+		EState	   *estate = node->ss.ps.state;
+		TupleTableSlot *scanslot = node->ss.ss_ScanTupleSlot;
+		MemoryContext oldcontext;
+
+		oldcontext = MemoryContextSwitchTo(estate->es_query_cxt);
+		node->batch_slots = palloc(sizeof(TupleTableSlot *) * EXEC_BATCH_SIZE);
+		for (int i = 0; i < EXEC_BATCH_SIZE; i++)
+			node->batch_slots[i] =
+				ExecAllocTableSlot(&estate->es_tupleTable,
+								   scanslot->tts_tupleDescriptor,
+								   scanslot->tts_ops);
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	return ExecScanBatch(&node->ss,
+						 (ExecScanBatchAccessMtd) SeqNextBatch,
+						 node->batch_slots, slots, maxslots);
+}
+
 
 /* ----------------------------------------------------------------
  *		ExecInitSeqScan
@@ -171,6 +244,16 @@ ExecInitSeqScan(SeqScan *node, EState *estate, int eflags)
 	scanstate->ss.ps.qual =
 		ExecInitQual(node->scan.plan.qual, (PlanState *) scanstate);
 
+	/*
+	 * Offer batch mode to the parent if tuples can be returned straight from
+	 * the scan.  SeqNextBatch copies heap tuple headers out of the scan
+	 * descriptor, so it's restricted to heap relations.
+	 */
+	if (scanstate->ss.ps.ps_ProjInfo == NULL &&
+		estate->es_epq_active == NULL &&
+		scanstate->ss.ss_currentRelation->rd_tableam == GetHeapamTableAmRoutine())
+		scanstate->ss.ps.ExecProcNodeBatch = ExecSeqScanBatch;
+
 	return scanstate;
 }
 
@@ -2099,10 +2099,10 @@ SPI_plan_get_cached_plan(SPIPlanPtr plan)
 	spierrcontext.previous = error_context_stack;
 	error_context_stack = &spierrcontext;
 
-	/* Get the generic plan for the query */
-	cplan = GetCachedPlan(plansource, NULL,
-						  plan->saved ? CurrentResourceOwner : NULL,
-						  _SPI_current->queryEnv);
+	/* Get the generic plan for the query, even if it reads session variables */
+	cplan = GetCachedPlanExt(plansource, NULL,
+							 plan->saved ? CurrentResourceOwner : NULL,
+							 _SPI_current->queryEnv, false);
 	Assert(cplan == plansource->gplan);
 
 	/* Pop the error context stack */
@@ -2763,6 +2763,11 @@ _SPI_execute_plan(SPIPlanPtr plan, const SPIExecuteOptions *options,
 					Assert(qc.commandTag == CMDTAG_COPY);
 					_SPI_current->processed = qc.nprocessed;
 				}
+				else if (IsA(stmt->utilityStmt, SetSessionVariableStmt))
+				{
+					/* Report it the same way as the planned SET @var */
+					res = SPI_OK_SET_SESSION_VARIABLE;
+				}
 			}
 
 			/*
@@ -161,12 +161,14 @@ void	   *referenced_functions[] =
 	ExecEvalParamExec,
 	ExecEvalParamExtern,
 	ExecEvalParamSet,
+	ExecEvalParamSesvar,
 	ExecEvalRow,
 	ExecEvalRowNotNull,
 	ExecEvalRowNull,
 	ExecEvalCoerceViaIOSafe,
 	ExecEvalSQLValueFunction,
 	ExecEvalScalarArrayOp,
+	ExecEvalSesVarExpr,
 	ExecEvalHashedScalarArrayOp,
 	ExecEvalSubPlan,
 	ExecEvalSysVar,
@@ -51,6 +51,8 @@ struct bloom_filter
 	unsigned char bitset[FLEXIBLE_ARRAY_MEMBER];
 };
 
+static bloom_filter *bloom_create_bitset(int64 total_elems,
+										 uint64 bitset_bytes, uint64 seed);
 static int	my_bloom_power(uint64 target_bitset_bits);
 static int	optimal_k(uint64 bitset_bits, int64 total_elems);
 static void k_hashes(bloom_filter *filter, uint32 *hashes, unsigned char *elem,
@@ -86,10 +88,7 @@ static inline uint32 mod_m(uint32 val, uint64 m);
 bloom_filter *
 bloom_create(int64 total_elems, int bloom_work_mem, uint64 seed)
 {
-	bloom_filter *filter;
-	int			bloom_power;
 	uint64		bitset_bytes;
-	uint64		bitset_bits;
 
 	/*
 	 * Aim for two bytes per element; this is sufficient to get a false
@@ -101,6 +100,39 @@ bloom_create(int64 total_elems, int bloom_work_mem, uint64 seed)
 	bitset_bytes = Min(bloom_work_mem * UINT64CONST(1024), total_elems * 2);
 	bitset_bytes = Max(1024 * 1024, bitset_bytes);
 
+	return bloom_create_bitset(total_elems, bitset_bytes, seed);
+}
+
+/*
+ * Create Bloom filter in caller's memory context, like bloom_create, but
+ * with a bitset of at most max_bytes.
+ *
+ * Unlike bloom_create, there is no 1MB minimum, for callers that have to
+ * stay within a small memory budget.  The false positive rate is only
+ * within the standard target band if max_bytes allows for about two bytes
+ * per element.
+ */
+bloom_filter *
+bloom_create_bounded(int64 total_elems, Size max_bytes, uint64 seed)
+{
+	uint64		bitset_bytes;
+
+	bitset_bytes = Min((uint64) max_bytes, total_elems * 2);
+	bitset_bytes = Max(1, bitset_bytes);
+
+	return bloom_create_bitset(total_elems, bitset_bytes, seed);
+}
+
+/*
+ * Create Bloom filter with a bitset of (at most) bitset_bytes.
+ */
+static bloom_filter *
+bloom_create_bitset(int64 total_elems, uint64 bitset_bytes, uint64 seed)
+{
+	bloom_filter *filter;
+	int			bloom_power;
+	uint64		bitset_bits;
+
 	/*
 	 * Size in bits should be the highest power of two <= target.  bitset_bits
 	 * is uint64 because PG_UINT32_MAX is 2^32 - 1, not 2^32
@@ -2203,7 +2203,15 @@ expression_tree_walker_impl(Node *node,
 		case T_NamedArgExpr:
 			return WALK(((NamedArgExpr *) node)->arg);
 		case T_SesVarExpr:
-			return WALK(((SesVarExpr *) node)->arg);
+			{
+				SesVarExpr *sesvar = (SesVarExpr *) node;
+
+				if (WALK(sesvar->upperindex))
+					return true;
+				if (WALK(sesvar->lowerindex))
+					return true;
+				return WALK(sesvar->arg);
+			}
 		case T_OpExpr:
 		case T_DistinctExpr:	/* struct-equivalent to OpExpr */
 		case T_NullIfExpr:		/* struct-equivalent to OpExpr */
@@ -3108,7 +3116,9 @@ expression_tree_mutator_impl(Node *node,
                 SesVarExpr *newnode;
 
                 FLATCOPY(newnode, nexpr, SesVarExpr);
-                MUTATE(newnode->arg, nexpr->arg, Expr *);
+                MUTATE(newnode->arg, nexpr->arg, Node *);
+                MUTATE(newnode->upperindex, nexpr->upperindex, Expr *);
+                MUTATE(newnode->lowerindex, nexpr->lowerindex, Expr *);
                 return (Node *) newnode;
             }
 		case T_NamedArgExpr:
@@ -4574,6 +4574,13 @@ cost_subplan(PlannerInfo *root, SubPlan *subplan, Plan *plan)
 			/* also charge a cpu_operator_cost per row examined */
 			sp_cost.per_tuple += 0.50 * plan->plan_rows * cpu_operator_cost;
 		}
+		else if (subplan->subLinkType == EXPR_SUBLINK &&
+				 root->parse->commandType == CMD_SET_SESSION_VARIABLE)
+		{
+			/* we need at most 2 tuples to assign a session variable */
+			sp_cost.per_tuple += plan_run_cost *
+				Min(1.0, 2.0 / clamp_row_est(plan->plan_rows));
+		}
 		else
 		{
 			/* assume we need all tuples */
@@ -26,6 +26,7 @@
 #include "nodes/makefuncs.h"
 #include "nodes/nodeFuncs.h"
 #include "nodes/supportnodes.h"
+#include "optimizer/clauses.h"
 #include "optimizer/cost.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/pathnode.h"
@@ -2218,6 +2219,16 @@ match_clause_to_indexcol(PlannerInfo *root,
 	if (clause == NULL)
 		return NULL;
 
+	/*
+	 * Index keys are computed once per scan, so a clause comparing against a
+	 * session variable is only usable if the query cannot change that
+	 * variable while scanning.  (Index expressions cannot contain Params, so
+	 * any session variable read must be on the comparison-value side.)
+	 */
+	if (root->glob->hasSesVarAssignments &&
+		contain_sesvar_reads((Node *) clause))
+		return NULL;
+
 	/* First check for boolean-index cases. */
 	opfamily = index->opfamily[indexcol];
 	if (IsBooleanOpfamily(opfamily))
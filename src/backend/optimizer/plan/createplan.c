@@ -7120,6 +7120,7 @@ make_modifysessionvariable(PlannerInfo *root, Plan *subplan,
     node->plan.targetlist = NIL;
     
     node->operation = operation;
+    node->assignColumns = root->parse->isSesVarInto;
     
     return node;
 }
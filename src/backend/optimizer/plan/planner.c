@@ -318,6 +318,8 @@ standard_planner(Query *parse, const char *query_string, int cursorOptions,
 	glob->resultRelations = NIL;
 	glob->appendRelations = NIL;
 	glob->relationOids = NIL;
+	glob->relationSesVars = NIL;
+	glob->peekSesVars = (cursorOptions & CURSOR_OPT_NO_SESVAR_PEEK) == 0;
 	glob->invalItems = NIL;
 	glob->paramExecTypes = NIL;
 	glob->lastPHId = 0;
@@ -371,6 +373,13 @@ standard_planner(Query *parse, const char *query_string, int cursorOptions,
 		glob->parallelModeOK = false;
 	}
 
+	/*
+	 * Session variables assigned by the query change while it runs, so index
+	 * scans and partition pruning must not use them as if they were stable.
+	 * That holds whether or not the query is a parallel candidate.
+	 */
+	glob->hasSesVarAssignments = contain_sesvar_assignment((Node *) parse);
+
 	/*
 	 * glob->parallelModeNeeded is normally set to false here and changed to
 	 * true during plan creation if a Gather or Gather Merge plan is actually
@@ -413,6 +422,14 @@ standard_planner(Query *parse, const char *query_string, int cursorOptions,
 		else if (tuple_fraction <= 0.0)
 			tuple_fraction = 1e-10;
 	}
+	else if (parse->commandType == CMD_SET_SESSION_VARIABLE)
+	{
+		/*
+		 * ModifySessionVariable stops at the second row, which can only be
+		 * fetched to report that the result does not fit into a variable.
+		 */
+		tuple_fraction = 2.0;
+	}
 	else
 	{
 		/* Default assumption is we need all the tuples */
@@ -563,6 +580,10 @@ standard_planner(Query *parse, const char *query_string, int cursorOptions,
 	result->relationOids = glob->relationOids;
 	result->invalItems = glob->invalItems;
 	result->paramExecTypes = glob->paramExecTypes;
+	result->sessionVariables = NIL;
+	foreach(lp, glob->relationSesVars)
+		result->sessionVariables = lappend(result->sessionVariables,
+										   makeString((char *) lfirst(lp)));
 	/* utilityStmt should be null, but we might as well copy it */
 	result->utilityStmt = parse->utilityStmt;
 	result->stmt_location = parse->stmt_location;
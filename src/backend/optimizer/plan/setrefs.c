@@ -157,6 +157,7 @@ static Plan *set_mergeappend_references(PlannerInfo *root,
 										int rtoffset);
 static void set_hash_references(PlannerInfo *root, Plan *plan, int rtoffset);
 static Relids offset_relid_set(Relids relids, int rtoffset);
+static void record_plan_sesvar_dependency(PlannerInfo *root, char *name);
 static Node *fix_scan_expr(PlannerInfo *root, Node *node,
 						   int rtoffset, double num_exec);
 static Node *fix_scan_expr_mutator(Node *node, fix_scan_expr_context *context);
@@ -2032,6 +2033,11 @@ fix_expr_common(PlannerInfo *root, Node *node)
 				lappend_oid(root->glob->relationOids,
 							DatumGetObjectId(con->constvalue));
 	}
+	else if (IsA(node, Param) &&
+			 ((Param *) node)->paramkind == PARAM_SESSION_VARIABLE)
+	{
+		record_plan_sesvar_dependency(root, ((Param *) node)->paramsesvarid);
+	}
 	else if (IsA(node, GroupingFunc))
 	{
 		GroupingFunc *g = (GroupingFunc *) node;
@@ -2070,6 +2076,9 @@ fix_expr_common(PlannerInfo *root, Node *node)
 static Node *
 fix_param_node(PlannerInfo *root, Param *p)
 {
+	if (p->paramkind == PARAM_SESSION_VARIABLE)
+		record_plan_sesvar_dependency(root, p->paramsesvarid);
+
 	if (p->paramkind == PARAM_MULTIEXPR)
 	{
 		int			subqueryid = p->paramid >> 16;
@@ -3481,6 +3490,29 @@ find_minmax_agg_replacement_param(PlannerInfo *root, Aggref *aggref)
  *					QUERY DEPENDENCY MANAGEMENT
  *****************************************************************************/
 
+/*
+ * record_plan_sesvar_dependency
+ *		Mark the current plan as reading a particular session variable.
+ *
+ * Each variable is remembered once.  The list serves both for plan
+ * invalidation when the variable changes its type and for passing the
+ * variable's value to parallel workers.
+ */
+static void
+record_plan_sesvar_dependency(PlannerInfo *root, char *name)
+{
+	ListCell   *lc;
+
+	foreach(lc, root->glob->relationSesVars)
+	{
+		if (strcmp((char *) lfirst(lc), name) == 0)
+			return;
+	}
+
+	root->glob->relationSesVars = lappend(root->glob->relationSesVars,
+										  pstrdup(name));
+}
+
 /*
  * record_plan_function_dependency
  *		Mark the current plan as depending on a particular function.
@@ -3614,10 +3646,6 @@ extract_query_dependencies_walker(Node *node, PlannerInfo *context)
 	if (node == NULL)
 		return false;
 	Assert(!IsA(node, PlaceHolderVar));
-	if (IsA(node, Param) && ((Param *) node)->paramkind == PARAM_SESSION_VARIABLE)
-        context->glob->relationSesVars = lappend(context->glob->relationSesVars,
-                                                pstrdup(((Param *) node)->paramsesvarid));   
-    
 	if (IsA(node, Query))
 	{
 		Query	   *query = (Query *) node;
@@ -3643,6 +3671,20 @@ extract_query_dependencies_walker(Node *node, PlannerInfo *context)
 				return false;
 			}
 
+			/*
+			 * Simple SET @var := expr is evaluated without planning, but its
+			 * transformed expressions still depend on functions and on the
+			 * types of the session variables they read.
+			 */
+			if (IsA(query->utilityStmt, SetSessionVariableStmt))
+			{
+				SetSessionVariableStmt *setstmt = (SetSessionVariableStmt *) query->utilityStmt;
+
+				(void) extract_query_dependencies_walker((Node *) setstmt->targetList,
+														 context);
+				return false;
+			}
+
 			/*
 			 * Ignore other utility statements, except those (such as EXPLAIN)
 			 * that contain a parsed-but-not-planned query.  For those, we
@@ -211,6 +211,9 @@ make_subplan(PlannerInfo *root, Query *orig_subquery,
 	else if (subLinkType == ALL_SUBLINK ||
 			 subLinkType == ANY_SUBLINK)
 		tuple_fraction = 0.5;	/* 50% */
+	else if (subLinkType == EXPR_SUBLINK &&
+			 root->parse->commandType == CMD_SET_SESSION_VARIABLE)
+		tuple_fraction = 2.0;	/* SET @var := (SELECT ...) fails on row 2 */
 	else
 		tuple_fraction = 0.0;	/* default behavior */
 
@@ -24,6 +24,7 @@
 #include "catalog/pg_operator.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
+#include "commands/sessionvariable.h"
 #include "executor/executor.h"
 #include "executor/functions.h"
 #include "funcapi.h"
@@ -90,11 +91,14 @@ typedef struct
 	char		max_hazard;		/* worst proparallel hazard found so far */
 	char		max_interesting;	/* worst proparallel hazard of interest */
 	List	   *safe_param_ids; /* PARAM_EXEC Param IDs to treat as safe */
+	bool		sesvar_reads_safe;	/* treat session variable reads as safe? */
 } max_parallel_hazard_context;
 
 static bool contain_agg_clause_walker(Node *node, void *context);
 static bool find_window_functions_walker(Node *node, WindowFuncLists *lists);
 static bool contain_subplans_walker(Node *node, void *context);
+static bool contain_sesvar_assignment_walker(Node *node, void *context);
+static bool contain_sesvar_reads_walker(Node *node, void *context);
 static bool contain_mutable_functions_walker(Node *node, void *context);
 static bool contain_volatile_functions_walker(Node *node, void *context);
 static bool contain_volatile_functions_not_nextval_walker(Node *node, void *context);
@@ -344,6 +348,63 @@ contain_subplans_walker(Node *node, void *context)
 	return expression_tree_walker(node, contain_subplans_walker, context);
 }
 
+/*
+ * contain_sesvar_assignment
+ *	  Recursively search for session variable assignments (SesVarExpr)
+ *	  within a clause, including sub-Queries.
+ */
+bool
+contain_sesvar_assignment(Node *clause)
+{
+	return contain_sesvar_assignment_walker(clause, NULL);
+}
+
+static bool
+contain_sesvar_assignment_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, SesVarExpr))
+		return true;
+	if (IsA(node, Query))
+		return query_tree_walker((Query *) node,
+								 contain_sesvar_assignment_walker,
+								 context, 0);
+	return expression_tree_walker(node, contain_sesvar_assignment_walker,
+								  context);
+}
+
+/*
+ * contain_sesvar_reads
+ *	  Recursively search for session variable reads (PARAM_SESSION_VARIABLE
+ *	  Params) within a clause, including sub-Queries.
+ *
+ * Such a Param is stable for the whole execution of a query unless the same
+ * query also assigns session variables, in which case its value may change
+ * from row to row and it must not be evaluated just once at executor startup.
+ */
+bool
+contain_sesvar_reads(Node *clause)
+{
+	return contain_sesvar_reads_walker(clause, NULL);
+}
+
+static bool
+contain_sesvar_reads_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, Param) &&
+		((Param *) node)->paramkind == PARAM_SESSION_VARIABLE)
+		return true;
+	if (IsA(node, Query))
+		return query_tree_walker((Query *) node,
+								 contain_sesvar_reads_walker,
+								 context, 0);
+	return expression_tree_walker(node, contain_sesvar_reads_walker,
+								  context);
+}
+
 
 /*****************************************************************************
  *		Check clauses for mutable functions
@@ -738,6 +799,8 @@ max_parallel_hazard(Query *parse)
 	context.max_hazard = PROPARALLEL_SAFE;
 	context.max_interesting = PROPARALLEL_UNSAFE;
 	context.safe_param_ids = NIL;
+	/* session variable assignments make the whole query restricted anyway */
+	context.sesvar_reads_safe = true;
 	(void) max_parallel_hazard_walker((Node *) parse, &context);
 	return context.max_hazard;
 }
@@ -770,6 +833,12 @@ is_parallel_safe(PlannerInfo *root, Node *node)
 	context.max_interesting = PROPARALLEL_RESTRICTED;
 	context.safe_param_ids = NIL;
 
+	/*
+	 * Workers get a copy of the session variables read by the query, which
+	 * is only good if the query doesn't change them while it runs.
+	 */
+	context.sesvar_reads_safe = !root->glob->hasSesVarAssignments;
+
 	/*
 	 * The params that refer to the same or parent query level are considered
 	 * parallel-safe.  The idea is that we compute such params at Gather or
@@ -873,6 +942,16 @@ max_parallel_hazard_walker(Node *node, max_parallel_hazard_context *context)
 			return true;
 	}
 
+	/*
+	 * Session variables can only be assigned in the leader, workers have no
+	 * way to pass the new value back.
+	 */
+	else if (IsA(node, SesVarExpr))
+	{
+		if (max_parallel_hazard_test(PROPARALLEL_RESTRICTED, context))
+			return true;
+	}
+
 	/*
 	 * As a notational convenience for callers, look through RestrictInfo.
 	 */
@@ -926,7 +1005,8 @@ max_parallel_hazard_walker(Node *node, max_parallel_hazard_context *context)
 	 * parallel-restricted, unless they are PARAM_EXTERN Params or are
 	 * PARAM_EXEC Params listed in safe_param_ids, meaning they could be
 	 * either generated within workers or can be computed by the leader and
-	 * then their value can be passed to workers.
+	 * then their value can be passed to workers.  Session variables are
+	 * passed to workers too, unless the query assigns to any of them.
 	 */
 	else if (IsA(node, Param))
 	{
@@ -935,6 +1015,10 @@ max_parallel_hazard_walker(Node *node, max_parallel_hazard_context *context)
 		if (param->paramkind == PARAM_EXTERN)
 			return false;
 
+		if (param->paramkind == PARAM_SESSION_VARIABLE &&
+			context->sesvar_reads_safe)
+			return false;
+
 		if (param->paramkind != PARAM_EXEC ||
 			!list_member_int(context->safe_param_ids, param->paramid))
 		{
@@ -2516,6 +2600,33 @@ eval_const_expressions_mutator(Node *node,
 					}
 				}
 
+				/*
+				 * Session variables can change while the plan runs, so their
+				 * current value may only be used for estimates, and only if
+				 * the plan is not meant to be reused for other values.  The
+				 * value must have the type of the Param already, converting
+				 * it could fail and estimation must not.
+				 */
+				if (param->paramkind == PARAM_SESSION_VARIABLE &&
+					context->estimate &&
+					context->root != NULL &&
+					context->root->glob != NULL &&
+					context->root->glob->peekSesVars)
+				{
+					Const	   *con;
+
+					con = getConstSessionVariable(param->paramsesvarid,
+												  UNKNOWNOID);
+					if (con != NULL && con->consttype == param->paramtype)
+					{
+						con = copyObject(con);
+						con->consttypmod = param->paramtypmod;
+						con->constcollid = param->paramcollid;
+						con->location = param->location;
+						return (Node *) con;
+					}
+				}
+
 				/*
 				 * Not replaceable, so just copy the Param (no need to
 				 * recurse)
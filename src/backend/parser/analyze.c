@@ -61,7 +61,9 @@ post_parse_analyze_hook_type post_parse_analyze_hook = NULL;
 static Query *transformOptionalSelectInto(ParseState *pstate, Node *parseTree);
 static Query *transformDeleteStmt(ParseState *pstate, DeleteStmt *stmt);
 static Query *transformInsertStmt(ParseState *pstate, InsertStmt *stmt);
-static Query *transformSetSessionVariableStmt(ParseState *pstate, SetSessionVariableStmt *stmt);
+static Query *transformSetSessionVariableStmt(ParseState *pstate, SetSessionVariableStmt *stmt,
+                                              bool planned);
+static Query *transformSelectIntoSessionVariables(ParseState *pstate, Node *parseTree);
 static OnConflictExpr *transformOnConflictClause(ParseState *pstate,
 												 OnConflictClause *onConflictClause);
 static int	count_rowexpr_columns(ParseState *pstate, Node *expr);
@@ -366,7 +368,9 @@ transformOptionalSelectInto(ParseState *pstate, Node *parseTree)
 			stmt = stmt->larg;
 		Assert(stmt && IsA(stmt, SelectStmt) && stmt->larg == NULL);
 
-		if (stmt->intoClause)
+		if (stmt->intoClause && stmt->intoClause->sesvars != NIL)
+			return transformSelectIntoSessionVariables(pstate, parseTree);
+		else if (stmt->intoClause)
 		{
 			CreateTableAsStmt *ctas = makeNode(CreateTableAsStmt);
 
@@ -389,6 +393,78 @@ transformOptionalSelectInto(ParseState *pstate, Node *parseTree)
 	return transformStmt(pstate, parseTree);
 }
 
+/*
+ * transformSelectIntoSessionVariables -
+ *	  transform SELECT expr [, ...] INTO @var [, ...] FROM ...
+ *
+ * Each output column is named after its session variable and the query is
+ * turned into a CMD_SET_SESSION_VARIABLE one. The ModifySessionVariable node
+ * on top of the plan makes sure the query returned at most one row and only
+ * then assigns the columns of that row to the variables, so a failing query
+ * leaves all of them untouched.
+ */
+static Query *
+transformSelectIntoSessionVariables(ParseState *pstate, Node *parseTree)
+{
+    SelectStmt *stmt = (SelectStmt *) parseTree;
+    IntoClause *into;
+    Query	   *qry;
+    ListCell   *lt,
+               *lv;
+
+    /* INTO belongs to the leftmost SelectStmt of a set-operation tree */
+    while (stmt->op != SETOP_NONE)
+        stmt = stmt->larg;
+    into = stmt->intoClause;
+
+    if ((Node *) stmt != parseTree)
+        ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                 errmsg("SELECT ... INTO session variables is not supported with UNION/INTERSECT/EXCEPT"),
+                 parser_errposition(pstate, exprLocation(linitial(into->sesvars)))));
+
+    foreach(lt, stmt->targetList)
+    {
+        ResTarget  *res = lfirst_node(ResTarget, lt);
+
+        if (IsA(res->val, ColumnRef) &&
+            IsA(llast(((ColumnRef *) res->val)->fields), A_Star))
+            ereport(ERROR,
+                    (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                     errmsg("SELECT * cannot be assigned to session variables"),
+                     parser_errposition(pstate, res->location)));
+    }
+
+    if (list_length(stmt->targetList) > list_length(into->sesvars))
+        ereport(ERROR,
+                (errcode(ERRCODE_SYNTAX_ERROR),
+                 errmsg("SELECT has more expressions than INTO session variables"),
+                 parser_errposition(pstate, exprLocation(linitial(into->sesvars)))));
+    if (list_length(stmt->targetList) < list_length(into->sesvars))
+        ereport(ERROR,
+                (errcode(ERRCODE_SYNTAX_ERROR),
+                 errmsg("SELECT has more INTO session variables than expressions"),
+                 parser_errposition(pstate, exprLocation(list_nth(into->sesvars,
+                                                                  list_length(stmt->targetList))))));
+
+    forboth(lt, stmt->targetList, lv, into->sesvars)
+    {
+        ResTarget  *res = lfirst_node(ResTarget, lt);
+        ColumnRef  *cref = lfirst_node(ColumnRef, lv);
+
+        res->name = strVal(linitial(cref->fields));
+    }
+
+    /* Same as for CREATE TABLE AS, a nested INTO is an error */
+    stmt->intoClause = NULL;
+
+    qry = transformStmt(pstate, parseTree);
+    qry->commandType = CMD_SET_SESSION_VARIABLE;
+    qry->isSesVarInto = true;
+
+    return qry;
+}
+
 /*
  * transformStmt -
  *	  recursively transform a Parse tree into a Query tree.
@@ -439,7 +515,7 @@ transformStmt(ParseState *pstate, Node *parseTree)
 			break;
 
         case T_SetSessionVariableStmt:
-            result = transformSetSessionVariableStmt(pstate, (SetSessionVariableStmt *) parseTree);
+            result = transformSetSessionVariableStmt(pstate, (SetSessionVariableStmt *) parseTree, false);
             break;
 
 		case T_DeleteStmt:
@@ -674,17 +750,43 @@ transformDeleteStmt(ParseState *pstate, DeleteStmt *stmt)
  * transformSetSessionVariableStmt -
  *	  transform an SET @var := expr [, @var := expr]
  *	  Session variables
+ *
+ * Statements whose expressions contain no sublinks, aggregates, window
+ * functions or set-returning functions are turned into a utility statement
+ * carrying the transformed assignments, which ExecuteSetSessionVariableStmt
+ * evaluates directly without going through the planner and the executor.
+ * planned forces the planned form, which EXPLAIN needs to have a plan to
+ * show and, with ANALYZE, to run.
  */
-static Query *transformSetSessionVariableStmt(ParseState *pstate, SetSessionVariableStmt *stmt)
+static Query *transformSetSessionVariableStmt(ParseState *pstate, SetSessionVariableStmt *stmt,
+                                              bool planned)
 {
     Query	   *qry = makeNode(Query);
+    List	   *targetList;
 
-    qry->commandType = CMD_SET_SESSION_VARIABLE;
     pstate->p_is_insert = false;
 
-    qry->targetList = transformTargetList(pstate, stmt->variables,
-                                          EXPR_KIND_SELECT_TARGET);
+    targetList = transformTargetList(pstate, stmt->variables,
+                                     EXPR_KIND_SELECT_TARGET);
 
+    if (!planned && !pstate->p_hasSubLinks && !pstate->p_hasAggs &&
+        !pstate->p_hasWindowFuncs && !pstate->p_hasTargetSRFs)
+    {
+        SetSessionVariableStmt *simple = makeNode(SetSessionVariableStmt);
+
+        simple->variables = stmt->variables;
+        simple->targetList = targetList;
+
+        assign_list_collations(pstate, targetList);
+
+        qry->commandType = CMD_UTILITY;
+        qry->utilityStmt = (Node *) simple;
+
+        return qry;
+    }
+
+    qry->commandType = CMD_SET_SESSION_VARIABLE;
+    qry->targetList = targetList;
     qry->hasSubLinks = pstate->p_hasSubLinks;
     qry->jointree = makeNode(FromExpr);
     qry->jointree->quals = NULL;
@@ -3110,8 +3212,24 @@ transformExplainStmt(ParseState *pstate, ExplainStmt *stmt)
 			setup_parse_variable_parameters(pstate, &paramTypes, &numParams);
 	}
 
-	/* transform contained query, allowing SELECT INTO */
-	stmt->query = (Node *) transformOptionalSelectInto(pstate, stmt->query);
+	/*
+	 * transform contained query, allowing SELECT INTO; a SET of session
+	 * variables keeps its planned form, see transformSetSessionVariableStmt
+	 */
+	if (IsA(stmt->query, SetSessionVariableStmt))
+	{
+		Query	   *qry;
+
+		qry = transformSetSessionVariableStmt(pstate,
+											  (SetSessionVariableStmt *) stmt->query,
+											  true);
+		qry->querySource = QSRC_ORIGINAL;
+		qry->canSetTag = true;
+		setQueryLocationAndLength(pstate, qry, stmt->query);
+		stmt->query = (Node *) qry;
+	}
+	else
+		stmt->query = (Node *) transformOptionalSelectInto(pstate, stmt->query);
 
 	/* make sure all is well with parameter types */
 	if (generic_plan)
@@ -438,6 +438,7 @@ static Node *makeRecursiveViewSelect(char *relname, List *aliases, Node *query);
 				TriggerTransitions TriggerReferencing
 				vacuum_relation_list opt_vacuum_relation_list
 				drop_option_list pub_obj_list session_variable_list
+				into_session_variable_list
 
 %type <node>	opt_routine_body SetSessionVariableItem
 %type <groupclause> group_clause
@@ -13107,10 +13108,37 @@ into_clause:
 					$$->viewQuery = NULL;
 					$$->skipData = false;
 				}
+            | INTO into_session_variable_list
+                {
+                    $$ = makeNode(IntoClause);
+                    $$->rel = NULL;
+                    $$->sesvars = $2;
+                    $$->colNames = NIL;
+                    $$->options = NIL;
+                    $$->onCommit = ONCOMMIT_NOOP;
+                    $$->tableSpaceName = NULL;
+                    $$->viewQuery = NULL;
+                    $$->skipData = false;
+                }
 			| /*EMPTY*/
 				{ $$ = NULL; }
 		;
 
+/*
+ * SELECT ... INTO @a, @b assigns the columns of the single result row
+ * to session variables instead of creating a table.
+ **/
+into_session_variable_list:
+            SESSION_VAR_NAME
+                {
+                    $$ = list_make1(makeColumnRef($1, NIL, @1, yyscanner));
+                }
+            | into_session_variable_list ',' SESSION_VAR_NAME
+                {
+                    $$ = lappend($1, makeColumnRef($3, NIL, @3, yyscanner));
+                }
+        ;
+
 /*
  * Redundancy here is needed to avoid shift/reduce conflicts,
  * since TEMP is not a reserved word.  See also OptTemp.
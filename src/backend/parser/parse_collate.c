@@ -341,6 +341,8 @@ assign_collations_walker(Node *node, assign_collations_context *context)
                 SesVarExpr *expr = (SesVarExpr *) node;
     
                 assign_expr_collations(context->pstate, expr->arg);
+                assign_expr_collations(context->pstate, (Node *) expr->upperindex);
+                assign_expr_collations(context->pstate, (Node *) expr->lowerindex);
                 /*
                  * Since the result is always composite and therefore never
                  * has a collation, we can just stop here: this node has no
@@ -55,6 +55,7 @@ static Node *transformAExprNullIf(ParseState *pstate, A_Expr *a);
 static Node *transformAExprIn(ParseState *pstate, A_Expr *a);
 static Node *transformAExprBetween(ParseState *pstate, A_Expr *a);
 static Node *transformAExprSessionVariable(ParseState *pstate, A_Expr *a);
+static Expr *transformSessionVariableSubscript(ParseState *pstate, Node *subscript);
 static Node *transformMergeSupportFunc(ParseState *pstate, MergeSupportFunc *f);
 static Node *transformBoolExpr(ParseState *pstate, BoolExpr *a);
 static Node *transformFuncCall(ParseState *pstate, FuncCall *fn);
@@ -1392,6 +1393,30 @@ transformAExprBetween(ParseState *pstate, A_Expr *a)
 	return transformExprRecurse(pstate, result);
 }
 
+/*
+ * Transform one subscript of a session variable array assignment and coerce
+ * it to int4, the same as array_subscript_transform() would do.
+ */
+static Expr *
+transformSessionVariableSubscript(ParseState *pstate, Node *subscript)
+{
+    Node *subexpr = transformExprRecurse(pstate, subscript);
+
+    subexpr = coerce_to_target_type(pstate,
+                                    subexpr, exprType(subexpr),
+                                    INT4OID, -1,
+                                    COERCION_ASSIGNMENT,
+                                    COERCE_IMPLICIT_CAST,
+                                    -1);
+    if (subexpr == NULL)
+        ereport(ERROR,
+                (errcode(ERRCODE_DATATYPE_MISMATCH),
+                 errmsg("array subscript must have type integer"),
+                 parser_errposition(pstate, exprLocation(subscript))));
+
+    return (Expr *) subexpr;
+}
+
 static Node *
 transformAExprSessionVariable(ParseState *pstate, A_Expr *a)
 {
@@ -1403,9 +1428,19 @@ transformAExprSessionVariable(ParseState *pstate, A_Expr *a)
     
     result->arg = transformExprRecurse(pstate, a->rexpr);
     if(IsA(a->lexpr, A_Indirection)){ /* Array indirection assign */
+        A_Indices *indices = (A_Indices *) linitial(((A_Indirection *) a->lexpr)->indirection);
+
         result->name = strVal((Node *) linitial(((ColumnRef *) ((A_Indirection *) a->lexpr)->arg)->fields));   
         result->strict_type = false;
-        result->indirection = ((A_Indirection *) a->lexpr)->indirection;
+
+        if (!IsA(indices, A_Indices) || indices->uidx == NULL ||
+            (indices->is_slice && indices->lidx == NULL))
+            elog(ERROR, "Session variable array indirection requires explicit subscripts.");
+
+        /* Subscripts are compiled along with the rest of the expression */
+        result->upperindex = transformSessionVariableSubscript(pstate, indices->uidx);
+        if (indices->lidx != NULL)
+            result->lowerindex = transformSessionVariableSubscript(pstate, indices->lidx);
         
         c = getConstSessionVariable(result->name, UNKNOWNOID);
         if(!c)
@@ -1419,7 +1454,8 @@ transformAExprSessionVariable(ParseState *pstate, A_Expr *a)
         result->strict_type = coerce = ((ColumnRef *) a->lexpr)->typeName != NULL;
         result->resulttype = result->strict_type == false ? exprType(result->arg) :
                              typenameTypeId(pstate, ((ColumnRef *) a->lexpr)->typeName);
-        result->indirection = NIL;
+        result->upperindex = NULL;
+        result->lowerindex = NULL;
     }
     
     if(coerce)
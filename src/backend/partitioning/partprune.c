@@ -46,6 +46,7 @@
 #include "nodes/makefuncs.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/appendinfo.h"
+#include "optimizer/clauses.h"
 #include "optimizer/cost.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/pathnode.h"
@@ -229,6 +230,26 @@ make_partition_pruneinfo(PlannerInfo *root, RelOptInfo *parentrel,
 	ListCell   *lc;
 	int			i;
 
+	/*
+	 * Session variables read by the pruning quals are only stable for the
+	 * whole execution if the query does not assign any; otherwise their
+	 * values may change from row to row, so don't use such quals for
+	 * run-time pruning.
+	 */
+	if (root->glob->hasSesVarAssignments)
+	{
+		List	   *stablequal = NIL;
+
+		foreach(lc, prunequal)
+		{
+			Node	   *qual = (Node *) lfirst(lc);
+
+			if (!contain_sesvar_reads(qual))
+				stablequal = lappend(stablequal, qual);
+		}
+		prunequal = stablequal;
+	}
+
 	/*
 	 * Scan the subpaths to see which ones are scans of partition child
 	 * relations, and identify their parent partitioned rels.  (Note: we must
@@ -26,6 +26,7 @@
 #include "access/xlogrecovery.h"
 #include "access/xlogwait.h"
 #include "commands/async.h"
+#include "commands/sessionvariable.h"
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "postmaster/autovacuum.h"
@@ -113,6 +114,7 @@ CalculateShmemSize(int *num_semaphores)
 											 sizeof(ShmemIndexEnt)));
 	size = add_size(size, dsm_estimate_size());
 	size = add_size(size, DSMRegistryShmemSize());
+	size = add_size(size, GlobalVariablesShmemSize());
 	size = add_size(size, BufferManagerShmemSize());
 	size = add_size(size, LockManagerShmemSize());
 	size = add_size(size, PredicateLockShmemSize());
@@ -278,6 +280,7 @@ CreateOrAttachShmemStructs(void)
 
 	dsm_shmem_init();
 	DSMRegistryShmemInit();
+	GlobalVariablesShmemInit();
 
 	/*
 	 * Set up xlog, clog, and buffers
@@ -158,6 +158,8 @@ static const char *const BuiltinTrancheNames[] = {
 	[LWTRANCHE_LAUNCHER_HASH] = "LogicalRepLauncherHash",
 	[LWTRANCHE_DSM_REGISTRY_DSA] = "DSMRegistryDSA",
 	[LWTRANCHE_DSM_REGISTRY_HASH] = "DSMRegistryHash",
+	[LWTRANCHE_GLOBAL_VARIABLES_DSA] = "GlobalVariablesDSA",
+	[LWTRANCHE_GLOBAL_VARIABLES_HASH] = "GlobalVariablesHash",
 	[LWTRANCHE_COMMITTS_SLRU] = "CommitTsSLRU",
 	[LWTRANCHE_MULTIXACTOFFSET_SLRU] = "MultixactOffsetSLRU",
 	[LWTRANCHE_MULTIXACTMEMBER_SLRU] = "MultixactMemberSLRU",
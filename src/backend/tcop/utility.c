@@ -48,6 +48,7 @@
 #include "commands/schemacmds.h"
 #include "commands/seclabel.h"
 #include "commands/sequence.h"
+#include "commands/sessionvariable.h"
 #include "commands/subscriptioncmds.h"
 #include "commands/tablecmds.h"
 #include "commands/tablespace.h"
@@ -874,6 +875,13 @@ standard_ProcessUtility(PlannedStmt *pstmt,
 			ExecSetVariableStmt((VariableSetStmt *) parsetree, isTopLevel);
 			break;
 
+		case T_SetSessionVariableStmt:
+			ExecuteSetSessionVariableStmt((SetSessionVariableStmt *) parsetree,
+										  params);
+			if (qc)
+				SetQueryCompletion(qc, CMDTAG_SET_SESSION_VARIABLE, 0);
+			break;
+
 		case T_VariableShowStmt:
 			{
 				VariableShowStmt *n = (VariableShowStmt *) parsetree;
@@ -3268,11 +3276,15 @@ GetCommandLogLevel(Node *parsetree)
 		case T_DeleteStmt:
 		case T_UpdateStmt:
 		case T_MergeStmt:
+		case T_SetSessionVariableStmt:
 			lev = LOGSTMT_MOD;
 			break;
 
 		case T_SelectStmt:
-			if (((SelectStmt *) parsetree)->intoClause)
+			if (((SelectStmt *) parsetree)->intoClause &&
+				((SelectStmt *) parsetree)->intoClause->sesvars != NIL)
+				lev = LOGSTMT_MOD;	/* SELECT INTO @var */
+			else if (((SelectStmt *) parsetree)->intoClause)
 				lev = LOGSTMT_DDL;	/* SELECT INTO */
 			else
 				lev = LOGSTMT_ALL;
@@ -11437,7 +11437,19 @@ get_const_collation(Const *constval, deparse_context *context)
 static void
 get_sesvar_expr(SesVarExpr *sesvar, deparse_context *context, bool showimplicit)
 {
-    appendStringInfo(context->buf, "%s := ", sesvar->name);
+    appendStringInfoString(context->buf, sesvar->name);
+
+    if (sesvar->upperindex) {
+        appendStringInfoChar(context->buf, '[');
+        if (sesvar->lowerindex) {
+            get_rule_expr((Node *) sesvar->lowerindex, context, false);
+            appendStringInfoChar(context->buf, ':');
+        }
+        get_rule_expr((Node *) sesvar->upperindex, context, false);
+        appendStringInfoChar(context->buf, ']');
+    }
+
+    appendStringInfoString(context->buf, " := ");
 
     get_rule_expr(sesvar->arg, context, showimplicit);
 }
@@ -59,6 +59,7 @@
 #include "access/transam.h"
 #include "catalog/namespace.h"
 #include "executor/executor.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/optimizer.h"
@@ -66,6 +67,7 @@
 #include "storage/lmgr.h"
 #include "tcop/pquery.h"
 #include "tcop/utility.h"
+#include "utils/hsearch.h"
 #include "utils/inval.h"
 #include "utils/memutils.h"
 #include "utils/resowner.h"
@@ -99,14 +101,30 @@ static dlist_head saved_plan_list = DLIST_STATIC_INIT(saved_plan_list);
  */
 static dlist_head cached_expression_list = DLIST_STATIC_INIT(cached_expression_list);
 
+/*
+ * Reverse index of the saved CachedPlanSources by the session variables they
+ * depend on (relationSesVars), so that a session variable changing its type
+ * only has to visit the plans that actually reference it.  Created on first
+ * use in CacheMemoryContext.
+ */
+typedef struct PlanCacheSesvarEntry
+{
+	char		name[SESVAR_SIZE];	/* session variable name (hash key) */
+	List	   *plansources;	/* saved CachedPlanSources depending on it */
+} PlanCacheSesvarEntry;
+
+static HTAB *sesvar_plan_index = NULL;
+
 static void ReleaseGenericPlan(CachedPlanSource *plansource);
 static List *RevalidateCachedQuery(CachedPlanSource *plansource,
 								   QueryEnvironment *queryEnv);
 static bool CheckCachedPlan(CachedPlanSource *plansource);
 static CachedPlan *BuildCachedPlan(CachedPlanSource *plansource, List *qlist,
-								   ParamListInfo boundParams, QueryEnvironment *queryEnv);
+								   ParamListInfo boundParams, bool generic,
+								   QueryEnvironment *queryEnv);
 static bool choose_custom_plan(CachedPlanSource *plansource,
-							   ParamListInfo boundParams);
+							   ParamListInfo boundParams,
+							   bool sesvarCustomPlans);
 static double cached_plan_cost(CachedPlan *plan, bool include_planner);
 static Query *QueryListGetPrimaryStmt(List *stmts);
 static void AcquireExecutorLocks(List *stmt_list, bool acquire);
@@ -116,6 +134,8 @@ static bool ScanQueryWalker(Node *node, bool *acquire);
 static TupleDesc PlanCacheComputeResultDesc(List *stmt_list);
 static void PlanCacheRelCallback(Datum arg, Oid relid);
 static void PlanCacheSesvarCallback(const char *name);
+static void PlanCacheIndexSesvars(CachedPlanSource *plansource);
+static void PlanCacheUnindexSesvars(CachedPlanSource *plansource);
 static void PlanCacheObjectCallback(Datum arg, int cacheid, uint32 hashvalue);
 static void PlanCacheSysCallback(Datum arg, int cacheid, uint32 hashvalue);
 
@@ -250,6 +270,7 @@ CreateCachedPlan(RawStmt *raw_parse_tree,
 	plansource->total_custom_cost = 0;
 	plansource->num_generic_plans = 0;
 	plansource->num_custom_plans = 0;
+	plansource->num_sesvar_invalidations = 0;
 
 	MemoryContextSwitchTo(oldcxt);
 
@@ -318,6 +339,7 @@ CreateOneShotCachedPlan(RawStmt *raw_parse_tree,
 	plansource->total_custom_cost = 0;
 	plansource->num_generic_plans = 0;
 	plansource->num_custom_plans = 0;
+	plansource->num_sesvar_invalidations = 0;
 
 	return plansource;
 }
@@ -515,6 +537,8 @@ SaveCachedPlan(CachedPlanSource *plansource)
 	dlist_push_tail(&saved_plan_list, &plansource->node);
 
 	plansource->is_saved = true;
+
+	PlanCacheIndexSesvars(plansource);
 }
 
 /*
@@ -533,6 +557,7 @@ DropCachedPlan(CachedPlanSource *plansource)
 	/* If it's been saved, remove it from the list */
 	if (plansource->is_saved)
 	{
+		PlanCacheUnindexSesvars(plansource);
 		dlist_delete(&plansource->node);
 		plansource->is_saved = false;
 	}
@@ -662,8 +687,11 @@ RevalidateCachedQuery(CachedPlanSource *plansource,
 	 * correctly in the race condition case.)
 	 */
 	plansource->is_valid = false;
+	if (plansource->is_saved)
+		PlanCacheUnindexSesvars(plansource);
 	plansource->query_list = NIL;
 	plansource->relationOids = NIL;
+	plansource->relationSesVars = NIL;
 	plansource->invalItems = NIL;
 	plansource->search_path = NULL;
 
@@ -798,6 +826,9 @@ RevalidateCachedQuery(CachedPlanSource *plansource,
 	plansource->query_context = querytree_context;
 	plansource->query_list = qlist;
 
+	if (plansource->is_saved)
+		PlanCacheIndexSesvars(plansource);
+
 	/*
 	 * Note: we do not reset generic_cost or total_custom_cost, although we
 	 * could choose to do so.  If the DDL or statistics change that prompted
@@ -897,10 +928,12 @@ CheckCachedPlan(CachedPlanSource *plansource)
  * or it can be set to NIL if we need to re-copy the plansource's query_list.
  *
  * To build a generic, parameter-value-independent plan, pass NULL for
- * boundParams.  To build a custom plan, pass the actual parameter values via
- * boundParams.  For best effect, the PARAM_FLAG_CONST flag should be set on
- * each parameter value; otherwise the planner will treat the value as a
- * hint rather than a hard constant.
+ * boundParams and generic = true.  To build a custom plan, pass the actual
+ * parameter values via boundParams.  For best effect, the PARAM_FLAG_CONST
+ * flag should be set on each parameter value; otherwise the planner will
+ * treat the value as a hint rather than a hard constant.  Custom plans may
+ * also use the current values of session variables for estimates, generic
+ * ones may not.
  *
  * Planning work is done in the caller's memory context.  The finished plan
  * is in a child memory context, which typically should get reparented
@@ -908,10 +941,12 @@ CheckCachedPlan(CachedPlanSource *plansource)
  */
 static CachedPlan *
 BuildCachedPlan(CachedPlanSource *plansource, List *qlist,
-				ParamListInfo boundParams, QueryEnvironment *queryEnv)
+				ParamListInfo boundParams, bool generic,
+				QueryEnvironment *queryEnv)
 {
 	CachedPlan *plan;
 	List	   *plist;
+	int			cursor_options;
 	bool		snapshot_set;
 	bool		is_transient;
 	MemoryContext plan_context;
@@ -963,8 +998,12 @@ BuildCachedPlan(CachedPlanSource *plansource, List *qlist,
 	/*
 	 * Generate the plan.
 	 */
+	cursor_options = plansource->cursor_options;
+	if (generic)
+		cursor_options |= CURSOR_OPT_NO_SESVAR_PEEK;
+
 	plist = pg_plan_queries(qlist, plansource->query_string,
-							plansource->cursor_options, boundParams);
+							cursor_options, boundParams);
 
 	/* Release snapshot if we got one */
 	if (snapshot_set)
@@ -1047,7 +1086,8 @@ BuildCachedPlan(CachedPlanSource *plansource, List *qlist,
  * This defines the policy followed by GetCachedPlan.
  */
 static bool
-choose_custom_plan(CachedPlanSource *plansource, ParamListInfo boundParams)
+choose_custom_plan(CachedPlanSource *plansource, ParamListInfo boundParams,
+				   bool sesvarCustomPlans)
 {
 	double		avg_custom_cost;
 
@@ -1055,8 +1095,14 @@ choose_custom_plan(CachedPlanSource *plansource, ParamListInfo boundParams)
 	if (plansource->is_oneshot)
 		return true;
 
-	/* Otherwise, never any point in a custom plan if there's no parameters */
-	if (boundParams == NULL)
+	/*
+	 * Otherwise, never any point in a custom plan if there's no parameters.
+	 * Session variables the statement reads count as parameters, since
+	 * custom plans are estimated using their current values, unless the
+	 * caller needs the generic plan.
+	 */
+	if (boundParams == NULL &&
+		(!sesvarCustomPlans || plansource->relationSesVars == NIL))
 		return false;
 	/* ... nor when planning would be a no-op */
 	if (!StmtPlanRequiresRevalidation(plansource))
@@ -1171,6 +1217,22 @@ cached_plan_cost(CachedPlan *plan, bool include_planner)
 CachedPlan *
 GetCachedPlan(CachedPlanSource *plansource, ParamListInfo boundParams,
 			  ResourceOwner owner, QueryEnvironment *queryEnv)
+{
+	return GetCachedPlanExt(plansource, boundParams, owner, queryEnv, true);
+}
+
+/*
+ * GetCachedPlanExt: GetCachedPlan with control over session variable plans.
+ *
+ * A statement without parameters that reads session variables normally gets
+ * custom plans, estimated with the current values of the variables.  Callers
+ * that must get the generic plan of such a statement, to keep reusing it
+ * (see SPI_plan_get_cached_plan), pass sesvarCustomPlans = false.
+ */
+CachedPlan *
+GetCachedPlanExt(CachedPlanSource *plansource, ParamListInfo boundParams,
+				 ResourceOwner owner, QueryEnvironment *queryEnv,
+				 bool sesvarCustomPlans)
 {
 	CachedPlan *plan = NULL;
 	List	   *qlist;
@@ -1187,7 +1249,8 @@ GetCachedPlan(CachedPlanSource *plansource, ParamListInfo boundParams,
 	qlist = RevalidateCachedQuery(plansource, queryEnv);
 
 	/* Decide whether to use a custom plan */
-	customplan = choose_custom_plan(plansource, boundParams);
+	customplan = choose_custom_plan(plansource, boundParams,
+											sesvarCustomPlans);
 
 	if (!customplan)
 	{
@@ -1200,7 +1263,7 @@ GetCachedPlan(CachedPlanSource *plansource, ParamListInfo boundParams,
 		else
 		{
 			/* Build a new generic plan */
-			plan = BuildCachedPlan(plansource, qlist, NULL, queryEnv);
+			plan = BuildCachedPlan(plansource, qlist, NULL, true, queryEnv);
 			/* Just make real sure plansource->gplan is clear */
 			ReleaseGenericPlan(plansource);
 			/* Link the new generic plan into the plansource */
@@ -1231,7 +1294,8 @@ GetCachedPlan(CachedPlanSource *plansource, ParamListInfo boundParams,
 			 * find it's a loser, but we don't want to actually execute that
 			 * plan.
 			 */
-			customplan = choose_custom_plan(plansource, boundParams);
+			customplan = choose_custom_plan(plansource, boundParams,
+											sesvarCustomPlans);
 
 			/*
 			 * If we choose to plan again, we need to re-copy the query_list,
@@ -1245,7 +1309,7 @@ GetCachedPlan(CachedPlanSource *plansource, ParamListInfo boundParams,
 	if (customplan)
 	{
 		/* Build a custom plan */
-		plan = BuildCachedPlan(plansource, qlist, boundParams, queryEnv);
+		plan = BuildCachedPlan(plansource, qlist, boundParams, false, queryEnv);
 		/* Accumulate total costs of custom plans */
 		plansource->total_custom_cost += cached_plan_cost(plan, true);
 
@@ -1613,6 +1677,7 @@ CopyCachedPlan(CachedPlanSource *plansource)
 	newsource->total_custom_cost = plansource->total_custom_cost;
 	newsource->num_generic_plans = plansource->num_generic_plans;
 	newsource->num_custom_plans = plansource->num_custom_plans;
+	newsource->num_sesvar_invalidations = plansource->num_sesvar_invalidations;
 
 	MemoryContextSwitchTo(oldcxt);
 
@@ -1986,18 +2051,22 @@ PlanCacheComputeResultDesc(List *stmt_list)
  */
 static void
 PlanCacheSesvarCallback(const char *name){
-    dlist_iter	iter;
+    PlanCacheSesvarEntry *entry;
+    ListCell *lc;
+
+    if (sesvar_plan_index == NULL)
+        return;
+
+    entry = (PlanCacheSesvarEntry *) hash_search(sesvar_plan_index, name, HASH_FIND, NULL);
 
-    dlist_foreach(iter, &saved_plan_list)
+    /* No saved plan depends on the sesvar */
+    if (entry == NULL)
+        return;
+
+    foreach (lc, entry->plansources)
     {
-        ListCell *lc;
-        CachedPlanSource *plansource = dlist_container(CachedPlanSource,
-                                                       node, iter.cur);
+        CachedPlanSource *plansource = (CachedPlanSource *) lfirst(lc);
 
-        /* If there's none sesvar -> nothing to do */
-        if(plansource->relationSesVars == NIL)
-            continue;
-        
         Assert(plansource->magic == CACHEDPLANSOURCE_MAGIC);
 
         /* No work if it's already invalidated */
@@ -2008,14 +2077,84 @@ PlanCacheSesvarCallback(const char *name){
         if (!StmtPlanRequiresRevalidation(plansource))
             continue;
 
-        /* If the plan depends on given sesvar -> Invalidate it */
-        foreach (lc, plansource->relationSesVars)
-        {
-            char *item = (char *) lfirst(lc);
-            
-            if (strcmp(item, name) == 0)
-                plansource->is_valid = false;
-        }
+        plansource->is_valid = false;
+        plansource->num_sesvar_invalidations++;
+        pgSesVarUsage.sesvar_invalidations++;
+    }
+}
+
+/*
+ * PlanCacheIndexSesvars
+ *		Add a saved plansource to the sesvar reverse index under each of
+ *		the session variables in its relationSesVars.
+ */
+static void
+PlanCacheIndexSesvars(CachedPlanSource *plansource)
+{
+    ListCell   *lc;
+
+    if (plansource->relationSesVars == NIL)
+        return;
+
+    if (sesvar_plan_index == NULL)
+    {
+        HASHCTL		ctl;
+
+        ctl.keysize = SESVAR_SIZE;
+        ctl.entrysize = sizeof(PlanCacheSesvarEntry);
+        ctl.hcxt = CacheMemoryContext;
+
+        sesvar_plan_index = hash_create("Plan cache sesvar index", 64, &ctl,
+                                        HASH_ELEM | HASH_STRINGS | HASH_CONTEXT);
+    }
+
+    foreach (lc, plansource->relationSesVars)
+    {
+        char	   *name = (char *) lfirst(lc);
+        PlanCacheSesvarEntry *entry;
+        MemoryContext oldcxt;
+        bool		found;
+
+        entry = (PlanCacheSesvarEntry *) hash_search(sesvar_plan_index, name, HASH_ENTER, &found);
+        if (!found)
+            entry->plansources = NIL;
+
+        /* The same sesvar may be referenced several times */
+        if (list_member_ptr(entry->plansources, plansource))
+            continue;
+
+        oldcxt = MemoryContextSwitchTo(CacheMemoryContext);
+        entry->plansources = lappend(entry->plansources, plansource);
+        MemoryContextSwitchTo(oldcxt);
+    }
+}
+
+/*
+ * PlanCacheUnindexSesvars
+ *		Remove a plansource from the sesvar reverse index, must be called
+ *		before its relationSesVars are discarded.
+ */
+static void
+PlanCacheUnindexSesvars(CachedPlanSource *plansource)
+{
+    ListCell   *lc;
+
+    if (sesvar_plan_index == NULL)
+        return;
+
+    foreach (lc, plansource->relationSesVars)
+    {
+        char	   *name = (char *) lfirst(lc);
+        PlanCacheSesvarEntry *entry;
+
+        entry = (PlanCacheSesvarEntry *) hash_search(sesvar_plan_index, name, HASH_FIND, NULL);
+        if (entry == NULL)
+            continue;
+
+        entry->plansources = list_delete_ptr(entry->plansources, plansource);
+
+        if (entry->plansources == NIL)
+            hash_search(sesvar_plan_index, name, HASH_REMOVE, NULL);
     }
 }
 
@@ -129,6 +129,7 @@ bool		enableFsync = true;
 bool		allowSystemTableMods = false;
 int			work_mem = 4096;
 double		hash_mem_multiplier = 2.0;
+int			hash_prefetch_depth = 0;
 int			maintenance_work_mem = 65536;
 int			max_parallel_maintenance_workers = 2;
 
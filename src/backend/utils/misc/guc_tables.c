@@ -40,12 +40,14 @@
 #include "catalog/storage.h"
 #include "commands/async.h"
 #include "commands/event_trigger.h"
+#include "commands/sessionvariable.h"
 #include "commands/tablespace.h"
 #include "commands/trigger.h"
 #include "commands/user.h"
 #include "commands/vacuum.h"
 #include "common/file_utils.h"
 #include "common/scram-common.h"
+#include "executor/executor.h"
 #include "jit/jit.h"
 #include "libpq/auth.h"
 #include "libpq/libpq.h"
@@ -2130,6 +2132,17 @@ struct config_int ConfigureNamesInt[] =
 		8, 1, INT_MAX,
 		NULL, NULL, NULL
 	},
+	{
+		{"hash_prefetch_depth", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets how many input tuples ahead hash joins and hash "
+						 "aggregation prefetch hash table buckets."),
+			gettext_noop("Zero disables prefetching."),
+			GUC_EXPLAIN
+		},
+		&hash_prefetch_depth,
+		0, 0, EXEC_BATCH_SIZE,
+		NULL, NULL, NULL
+	},
 	{
 		{"join_collapse_limit", PGC_USERSET, QUERY_TUNING_OTHER,
 			gettext_noop("Sets the FROM-list size beyond which JOIN "
@@ -2552,6 +2565,28 @@ struct config_int ConfigureNamesInt[] =
 		check_max_stack_depth, assign_max_stack_depth, NULL
 	},
 
+	{
+		{"session_variables_memory_limit", PGC_SUSET, RESOURCES_MEM,
+			gettext_noop("Limits the total memory used by the values of session variables of each process."),
+			gettext_noop("-1 means no limit."),
+			GUC_UNIT_KB
+		},
+		&session_variables_memory_limit,
+		-1, -1, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"global_variables_memory_limit", PGC_SIGHUP, RESOURCES_MEM,
+			gettext_noop("Limits the total shared memory used by the values of global variables."),
+			gettext_noop("-1 means no limit."),
+			GUC_UNIT_KB
+		},
+		&global_variables_memory_limit,
+		-1, -1, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"temp_file_limit", PGC_SUSET, RESOURCES_DISK,
 			gettext_noop("Limits the total size of all temporary files used by each process."),
@@ -619,6 +619,211 @@ qsort_tuple_int32_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 #define ST_DEFINE
 #include "lib/sort_template.h"
 
+/*
+ * Radix sort for SortTuples whose leading datum1 is compared by one of the
+ * specialized comparators above.  Those compare datum1 as an unsigned,
+ * signed or int32 integer, so datum1 can be mapped to an unsigned key whose
+ * byte-wise order is the sort order, and the tuples sorted by the key's
+ * bytes from the most significant one down (an in-place MSD or "American
+ * flag" radix sort).  Partitions whose keys are all equal are handed to the
+ * specialized qsort to break ties with the remaining keys, as are partitions
+ * too small to be worth another radix pass.
+ *
+ * Radix sorting is only used for sorts of at least RADIX_SORT_THRESHOLD
+ * tuples; partitions below RADIX_SORT_MIN_PARTITION tuples are left to qsort.
+ */
+#define RADIX_SORT_THRESHOLD		1024
+#define RADIX_SORT_MIN_PARTITION	64
+
+/*
+ * Sort the tuples with the specialized qsort for the leading key's comparator.
+ */
+static void
+qsort_tuple_leading(SortTuple *begin, size_t n, Tuplesortstate *state)
+{
+	SortSupport ssup = &state->base.sortKeys[0];
+
+	if (ssup->comparator == ssup_datum_unsigned_cmp)
+		qsort_tuple_unsigned(begin, n, state);
+#if SIZEOF_DATUM >= 8
+	else if (ssup->comparator == ssup_datum_signed_cmp)
+		qsort_tuple_signed(begin, n, state);
+#endif
+	else
+	{
+		Assert(ssup->comparator == ssup_datum_int32_cmp);
+		qsort_tuple_int32(begin, n, state);
+	}
+}
+
+/*
+ * Map a non-NULL datum1 to its radix sort key.
+ */
+static inline uint64
+radix_sort_key(Datum datum, SortSupport ssup)
+{
+	uint64		key;
+
+	if (ssup->comparator == ssup_datum_int32_cmp)
+		key = (uint32) DatumGetInt32(datum) ^ UINT64CONST(0x80000000);
+#if SIZEOF_DATUM >= 8
+	else if (ssup->comparator == ssup_datum_signed_cmp)
+		key = (uint64) datum ^ (UINT64CONST(1) << 63);
+#endif
+	else
+		key = (uint64) datum;
+
+	if (ssup->ssup_reverse)
+		key = ~key;
+
+	return key;
+}
+
+#define RADIX_SORT_BYTE(tup, ssup, shift) \
+	((int) ((radix_sort_key((tup)->datum1, (ssup)) >> (shift)) & 0xFF))
+
+/*
+ * Sort n tuples with non-NULL datum1 on byte number level (counting from the
+ * most significant one) of their keybytes long radix sort keys, and recurse
+ * into the resulting partitions.
+ */
+static void
+radix_sort_tuple(SortTuple *begin, size_t n, int level, int keybytes,
+				 Tuplesortstate *state)
+{
+	SortSupport ssup = &state->base.sortKeys[0];
+	int			shift = (keybytes - 1 - level) * BITS_PER_BYTE;
+	size_t		counts[256] = {0};
+	size_t		next[256];
+	size_t		end[256];
+	size_t		offset;
+
+	CHECK_FOR_INTERRUPTS();
+
+	for (size_t i = 0; i < n; i++)
+		counts[RADIX_SORT_BYTE(&begin[i], ssup, shift)]++;
+
+	offset = 0;
+	for (int b = 0; b < 256; b++)
+	{
+		next[b] = offset;
+		offset += counts[b];
+		end[b] = offset;
+	}
+
+	/*
+	 * Move each tuple into its partition by swapping it with the tuple at the
+	 * next free slot of that partition, until every slot holds a tuple that
+	 * belongs there.
+	 */
+	for (int b = 0; b < 256; b++)
+	{
+		while (next[b] < end[b])
+		{
+			SortTuple  *tup = &begin[next[b]];
+			int			tb = RADIX_SORT_BYTE(tup, ssup, shift);
+
+			if (tb == b)
+				next[b]++;
+			else
+			{
+				SortTuple	tmp = *tup;
+
+				*tup = begin[next[tb]];
+				begin[next[tb]++] = tmp;
+			}
+		}
+	}
+
+	offset = 0;
+	for (int b = 0; b < 256; b++)
+	{
+		SortTuple  *part = begin + offset;
+		size_t		npart = counts[b];
+
+		offset += npart;
+		if (npart <= 1)
+			continue;
+
+		if (level + 1 == keybytes)
+		{
+			/* all keys are equal, so only the other sort keys are left */
+			if (state->base.onlyKey == NULL)
+				qsort_tuple_leading(part, npart, state);
+		}
+		else if (npart < RADIX_SORT_MIN_PARTITION)
+			qsort_tuple_leading(part, npart, state);
+		else
+			radix_sort_tuple(part, npart, level + 1, keybytes, state);
+	}
+}
+
+/*
+ * Sort memtuples with a radix sort, if the leading key allows it.
+ *
+ * Returns false if the leading key's comparator isn't one that radix sorting
+ * supports, in which case nothing was done.
+ */
+static bool
+radix_sort_memtuples(Tuplesortstate *state)
+{
+	SortSupport ssup = &state->base.sortKeys[0];
+	SortTuple  *memtuples = state->memtuples;
+	size_t		n = state->memtupcount;
+	size_t		nfirst = 0;
+	SortTuple  *nulls;
+	SortTuple  *notnulls;
+	size_t		nnulls;
+	int			keybytes;
+
+	if (ssup->comparator == ssup_datum_unsigned_cmp)
+		keybytes = SIZEOF_DATUM;
+#if SIZEOF_DATUM >= 8
+	else if (ssup->comparator == ssup_datum_signed_cmp)
+		keybytes = SIZEOF_DATUM;
+#endif
+	else if (ssup->comparator == ssup_datum_int32_cmp)
+		keybytes = sizeof(int32);
+	else
+		return false;
+
+	/* Move the tuples sorting before the others (NULLs or not) to the front */
+	for (size_t i = 0; i < n; i++)
+	{
+		if (memtuples[i].isnull1 == ssup->ssup_nulls_first)
+		{
+			SortTuple	tmp = memtuples[i];
+
+			memtuples[i] = memtuples[nfirst];
+			memtuples[nfirst++] = tmp;
+		}
+	}
+
+	if (ssup->ssup_nulls_first)
+	{
+		nulls = memtuples;
+		nnulls = nfirst;
+		notnulls = memtuples + nfirst;
+	}
+	else
+	{
+		notnulls = memtuples;
+		nulls = memtuples + nfirst;
+		nnulls = n - nfirst;
+	}
+
+	/* NULLs are all equal on the leading key */
+	if (nnulls > 1 && state->base.onlyKey == NULL)
+		qsort_tuple_leading(nulls, nnulls, state);
+
+	if (n - nnulls >= RADIX_SORT_MIN_PARTITION)
+		radix_sort_tuple(notnulls, n - nnulls, 0, keybytes, state);
+	else if (n - nnulls > 1)
+		qsort_tuple_leading(notnulls, n - nnulls, state);
+
+	return true;
+}
+
 /*
  *		tuplesort_begin_xxx
  *
@@ -2685,6 +2890,11 @@ tuplesort_sort_memtuples(Tuplesortstate *state)
 		 */
 		if (state->base.haveDatum1 && state->base.sortKeys)
 		{
+			/* Large sorts on such keys are faster with a radix sort */
+			if (state->memtupcount >= RADIX_SORT_THRESHOLD &&
+				radix_sort_memtuples(state))
+				return;
+
 			if (state->base.sortKeys[0].comparator == ssup_datum_unsigned_cmp)
 			{
 				qsort_tuple_unsigned(state->memtuples,
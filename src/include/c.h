@@ -314,6 +314,18 @@
 #define unlikely(x) ((x) != 0)
 #endif
 
+/*
+ * Hint to the CPU to start loading the cache line containing the given
+ * address, because it's going to be accessed soon.  This never faults, even
+ * for invalid addresses, and is a no-op where the compiler doesn't support
+ * it.
+ */
+#if defined(__GNUC__) || defined(__INTEL_COMPILER)
+#define pg_prefetch_mem(a)	__builtin_prefetch(a)
+#else
+#define pg_prefetch_mem(a)	((void) (a))
+#endif
+
 /*
  * CppAsString
  *		Convert the argument to a string, using the C preprocessor.
@@ -14,13 +14,76 @@
 #ifndef PGSQL_SESSIONVARIABLE_H
 #define PGSQL_SESSIONVARIABLE_H
 
+#include "fmgr.h"
 #include "nodes/parsenodes.h"
 #include "parser/parse_node.h"
 #include "nodes/params.h"
 #include "tcop/dest.h"
 
+/*
+ * How a stored value is converted to the type requested by the reader.
+ */
+typedef enum SessionVariableCastMethod
+{
+    SESVAR_CAST_NONE,           /* nothing set up yet */
+    SESVAR_CAST_RELABEL,        /* binary coercible, hand out as is */
+    SESVAR_CAST_IO,             /* output + input function call, no cast exists */
+    SESVAR_CAST_COERCE,         /* anything else, goes through coerce_type */
+} SessionVariableCastMethod;
+
+/*
+ * Resolved reference to a session variable slot.
+ *
+ * Built once per @var occurrence when an expression is compiled, so that the
+ * executor does not have to hash the variable name on every evaluation.  The
+ * cached slot is only trusted while generation matches the generation of the
+ * session variable table it was looked up in.
+ *
+ * Reads of a value stored with another type than the requested one also
+ * cache the conversion path, which is redone whenever the stored type changes.
+ */
+typedef struct SessionVariableRef
+{
+    char       *name;           /* session variable id = @var */
+    sessionVariable *variable;  /* cached hash table slot, or NULL */
+    uint64      generation;     /* table generation the slot belongs to */
+
+    SessionVariableCastMethod castmethod;
+    Oid         castsource;     /* stored type the cast was set up for */
+    Oid         casttarget;     /* requested type the cast was set up for */
+    MemoryContext castcontext;  /* holds the FmgrInfos below, or NULL */
+    FmgrInfo    castoutput;     /* output function of castsource */
+    FmgrInfo    castinput;      /* input function of casttarget */
+    Oid         castioparam;    /* typioparam of casttarget */
+} SessionVariableRef;
+
+/*
+ * Evaluated (1-based) subscripts of an @var[lower:upper] := x assignment,
+ * lower equals upper when a single element is assigned.
+ */
+typedef struct SessionVariableSubscripts
+{
+    int         lower;
+    int         upper;
+} SessionVariableSubscripts;
+
+/*
+ * Global variables (@@var, written @"@var") are shared by all backends of
+ * the cluster, they are told apart from session variables by the name only.
+ */
+#define IsGlobalVariableName(name) ((name)[0] == '@' && (name)[1] == '@')
+
+/* GUC: cap on the memory held by the values of all session variables */
+extern PGDLLIMPORT int session_variables_memory_limit;
+
+/* GUC: cap on the shared memory held by the values of global variables */
+extern PGDLLIMPORT int global_variables_memory_limit;
+
+/* Hook for flushing deferred assignments, see sessionvariable.c */
+typedef void (*session_variable_flush_hook_type) (void);
+extern PGDLLIMPORT session_variable_flush_hook_type session_variable_flush_hook;
 
-extern void saveSessionVariable(sessionVariable *result, Node *expr, bool exists, List *indirection, bool new_strict_type);
+extern void saveSessionVariable(sessionVariable *result, Node *expr, bool exists, SessionVariableSubscripts *subscripts, bool new_strict_type);
 
 extern Node *
 makeConstSessionVariable(Oid typid, int32 typmod, Oid collid, bool typByVal, int16 typLen, bool isnull, Datum value);
@@ -31,6 +94,31 @@ getParamSessionVariable(char *name);
 extern Const *
 getConstSessionVariable(char *name, Oid type);
 
-extern void setSessionVariable(char *varname, Node *expr, List *indirection, bool new_strict_type);
+extern void setSessionVariable(char *varname, Node *expr, SessionVariableSubscripts *subscripts, bool new_strict_type);
+
+extern Const *prepareSessionVariableValue(char *varname, Const *value);
+
+extern void ExecuteSetSessionVariableStmt(SetSessionVariableStmt *stmt, ParamListInfo params);
+
+extern SessionVariableRef *makeSessionVariableRef(char *name);
+
+extern sessionVariable *lookupSessionVariable(SessionVariableRef *ref);
+
+extern Const *
+getConstSessionVariableRef(SessionVariableRef *ref, Oid type);
+
+extern void setSessionVariableRef(SessionVariableRef *ref, Node *expr, SessionVariableSubscripts *subscripts, bool new_strict_type);
+
+extern bool readSessionVariableRef(SessionVariableRef *ref, Oid type, Datum *value, bool *isnull);
+
+extern Size EstimateSessionVariablesSpace(List *names);
+
+extern void SerializeSessionVariables(List *names, char **start_address);
+
+extern void RestoreSessionVariables(char **start_address);
+
+extern Size GlobalVariablesShmemSize(void);
+
+extern void GlobalVariablesShmemInit(void);
 
 #endif //PGSQL_SESSIONVARIABLE_H
\ No newline at end of file
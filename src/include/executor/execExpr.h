@@ -21,8 +21,10 @@
 /* forward references to avoid circularity */
 struct ExprEvalStep;
 struct SubscriptingRefState;
+struct SesVarSubscriptState;
 struct ScalarArrayOpExprHashTable;
 struct JsonConstructorExprState;
+struct SessionVariableRef;
 
 /* Bits in ExprState->flags (see also execnodes.h for public flag bits): */
 /* expression's interpreter has been initialized */
@@ -405,14 +407,16 @@ typedef struct ExprEvalStep
 			Oid			paramtype;	/* OID of parameter's datatype */
 		}			param;
 
-        /* for EEOP_PARAM_SESVAR */
+        /* for EEOP_PARAM_SESVAR and EEOP_SESVAREXPR */
         struct
         {
-            char	    *sesvarid;	    /* char* ID for sesvar */
+            struct SessionVariableRef *sesvarref;	/* resolved sesvar slot */
             Oid			 sesvartype;	/* OID of sesvar's datatype */
             Oid			 sesvarcollid;	/* OID of sesvar's collation */
-            List	    *sesvarindirection;	/* OID of sesvar's array indirection */
-            bool		 sesvarstricttype;	/* OID of sesvar's collation */
+            struct SesVarSubscriptState *sesvarsubscripts;	/* array subscripts, or NULL */
+            int16		 sesvartyplen;	/* typlen of sesvartype */
+            bool		 sesvartypbyval;	/* typbyval of sesvartype */
+            bool		 sesvarstricttype;	/* is sesvartype strict */
         }			sesvar;
 
 		/* for EEOP_PARAM_CALLBACK */
@@ -805,6 +809,18 @@ typedef struct SubscriptExecSteps
 	ExecEvalSubroutine sbs_fetch_old;	/* fetch old value for assignment */
 } SubscriptExecSteps;
 
+/* Non-inline data for session variable array assignment (EEOP_SESVAREXPR) */
+typedef struct SesVarSubscriptState
+{
+	bool		isslice;		/* is it @var[lower:upper] := x? */
+
+	/* subscript values, filled by the steps preceding EEOP_SESVAREXPR */
+	Datum		upperindex;
+	bool		upperindexnull;
+	Datum		lowerindex;
+	bool		lowerindexnull;
+} SesVarSubscriptState;
+
 /* EEOP_JSON_CONSTRUCTOR state, too big to inline */
 typedef struct JsonConstructorExprState
 {
@@ -846,6 +862,10 @@ extern void ExecEvalParamSet(ExprState *state, ExprEvalStep *op,
 							 ExprContext *econtext);
 extern void ExecEvalParamExtern(ExprState *state, ExprEvalStep *op,
 								ExprContext *econtext);
+extern void ExecEvalParamSesvar(ExprState *state, ExprEvalStep *op,
+								ExprContext *econtext);
+extern void ExecEvalSesVarExpr(ExprState *state, ExprEvalStep *op,
+							   ExprContext *econtext);
 extern void ExecEvalCoerceViaIOSafe(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalSQLValueFunction(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalCurrentOfExpr(ExprState *state, ExprEvalStep *op);
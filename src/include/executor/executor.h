@@ -154,6 +154,7 @@ extern TupleHashEntry LookupTupleHashEntry(TupleHashTable hashtable,
 										   bool *isnew, uint32 *hash);
 extern uint32 TupleHashTableHash(TupleHashTable hashtable,
 								 TupleTableSlot *slot);
+extern void PrefetchTupleHashEntry(TupleHashTable hashtable, uint32 hash);
 extern TupleHashEntry LookupTupleHashEntryHash(TupleHashTable hashtable,
 											   TupleTableSlot *slot,
 											   bool *isnew, uint32 hash);
@@ -260,6 +261,11 @@ extern Node *MultiExecProcNode(PlanState *node);
 extern void ExecEndNode(PlanState *node);
 extern void ExecShutdownNode(PlanState *node);
 extern void ExecSetTupleBound(int64 tuples_needed, PlanState *child_node);
+extern int	ExecProcNodeBatch(PlanState *node, TupleTableSlot **slots,
+							  int maxslots);
+
+/* Largest number of tuples ExecProcNodeBatch may be asked for at once */
+#define EXEC_BATCH_SIZE		64
 
 
 /* ----------------------------------------------------------------
@@ -483,9 +489,13 @@ extern Datum ExecMakeFunctionResultSet(SetExprState *fcache,
  */
 typedef TupleTableSlot *(*ExecScanAccessMtd) (ScanState *node);
 typedef bool (*ExecScanRecheckMtd) (ScanState *node, TupleTableSlot *slot);
+typedef bool (*ExecScanBatchAccessMtd) (ScanState *node, TupleTableSlot *slot);
 
 extern TupleTableSlot *ExecScan(ScanState *node, ExecScanAccessMtd accessMtd,
 								ExecScanRecheckMtd recheckMtd);
+extern int	ExecScanBatch(ScanState *node, ExecScanBatchAccessMtd accessMtd,
+						  TupleTableSlot **batchslots,
+						  TupleTableSlot **slots, int maxslots);
 extern void ExecAssignScanProjectionInfo(ScanState *node);
 extern void ExecAssignScanProjectionInfoWithVarno(ScanState *node, int varno);
 extern void ExecScanReScan(ScanState *node);
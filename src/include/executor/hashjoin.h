@@ -91,6 +91,21 @@ typedef struct HashJoinTupleData
 #define HJTUPLE_MINTUPLE(hjtup)  \
 	((MinimalTuple) ((char *) (hjtup) + HJTUPLE_OVERHEAD))
 
+/*
+ * The Bloom filter of a multi-batch hash join is given up on if fewer than
+ * BLOOM_FILTER_MIN_REJECTED of the first BLOOM_FILTER_SAMPLE_TUPLES outer
+ * tuples (or of all checked so far, past that) get rejected by it.
+ */
+#define BLOOM_FILTER_SAMPLE_TUPLES	1000
+#define BLOOM_FILTER_MIN_REJECTED	0.1
+
+/*
+ * A filter sized for the inner row estimate has about half of its bits set
+ * once built.  More than BLOOM_FILTER_MAX_BITS_SET means the estimate was far
+ * off and the filter would let most outer tuples through, so it is dropped.
+ */
+#define BLOOM_FILTER_MAX_BITS_SET	0.75
+
 /*
  * If the outer relation's distribution is sufficiently nonuniform, we attempt
  * to optimize the join by treating the hash values corresponding to the outer
@@ -341,6 +356,16 @@ typedef struct HashJoinTableData
 	BufFile   **innerBatchFile; /* buffered virtual temp file per batch */
 	BufFile   **outerBatchFile; /* buffered virtual temp file per batch */
 
+	/*
+	 * Bloom filter over the hash values of all inner tuples, or NULL.  Only
+	 * built for multi-batch joins that can discard unmatched outer tuples;
+	 * see ExecHashBuildBloomFilter.
+	 */
+	struct bloom_filter *bloomFilter;
+	Size		bloomSpace;		/* memory used by it, counted in spaceUsed */
+	double		bloomChecked;	/* # outer tuples checked against it */
+	double		bloomRejected;	/* # outer tuples it rejected */
+
 	Size		spaceUsed;		/* memory space currently used by tuples */
 	Size		spaceAllowed;	/* upper limit for space used */
 	Size		spacePeak;		/* peak space used */
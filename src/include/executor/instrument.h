@@ -55,6 +55,20 @@ typedef struct WalUsage
 	uint64		wal_bytes;		/* size of WAL records produced */
 } WalUsage;
 
+/*
+ * SessionVariableUsage tracks the work done on session variables, displayed
+ * by EXPLAIN (ANALYZE, SESSION_VARIABLES).  Like the counters above, these
+ * are never reset.
+ */
+typedef struct SessionVariableUsage
+{
+	int64		sesvar_reads;	/* # of session variable reads */
+	int64		sesvar_writes;	/* # of session variable assignments */
+	int64		sesvar_coercions;	/* # of reads converting the stored type */
+	uint64		sesvar_bytes;	/* size of values copied into variables */
+	int64		sesvar_invalidations;	/* # of cached plans invalidated */
+} SessionVariableUsage;
+
 /* Flag bits included in InstrAlloc's instrument_options bitmask */
 typedef enum InstrumentOption
 {
@@ -62,6 +76,7 @@ typedef enum InstrumentOption
 	INSTRUMENT_BUFFERS = 1 << 1,	/* needs buffer usage */
 	INSTRUMENT_ROWS = 1 << 2,	/* needs row count */
 	INSTRUMENT_WAL = 1 << 3,	/* needs WAL usage */
+	INSTRUMENT_SESVARS = 1 << 4,	/* needs session variable usage */
 	INSTRUMENT_ALL = PG_INT32_MAX
 } InstrumentOption;
 
@@ -71,6 +86,7 @@ typedef struct Instrumentation
 	bool		need_timer;		/* true if we need timer data */
 	bool		need_bufusage;	/* true if we need buffer usage data */
 	bool		need_walusage;	/* true if we need WAL usage data */
+	bool		need_sesvarusage;	/* true if we need session variable usage */
 	bool		async_mode;		/* true if node is in async mode */
 	/* Info about current plan cycle: */
 	bool		running;		/* true if we've completed first tuple */
@@ -80,6 +96,7 @@ typedef struct Instrumentation
 	double		tuplecount;		/* # of tuples emitted so far this cycle */
 	BufferUsage bufusage_start; /* buffer usage at start */
 	WalUsage	walusage_start; /* WAL usage at start */
+	SessionVariableUsage sesvarusage_start; /* session variable usage at start */
 	/* Accumulated statistics across all completed cycles: */
 	double		startup;		/* total startup time (in seconds) */
 	double		total;			/* total time (in seconds) */
@@ -90,6 +107,7 @@ typedef struct Instrumentation
 	double		nfiltered2;		/* # of tuples removed by "other" quals */
 	BufferUsage bufusage;		/* total buffer usage */
 	WalUsage	walusage;		/* total WAL usage */
+	SessionVariableUsage sesvarusage;	/* total session variable usage */
 } Instrumentation;
 
 typedef struct WorkerInstrumentation
@@ -100,6 +118,7 @@ typedef struct WorkerInstrumentation
 
 extern PGDLLIMPORT BufferUsage pgBufferUsage;
 extern PGDLLIMPORT WalUsage pgWalUsage;
+extern PGDLLIMPORT SessionVariableUsage pgSesVarUsage;
 
 extern Instrumentation *InstrAlloc(int n, int instrument_options,
 								   bool async_mode);
@@ -116,5 +135,8 @@ extern void BufferUsageAccumDiff(BufferUsage *dst,
 								 const BufferUsage *add, const BufferUsage *sub);
 extern void WalUsageAccumDiff(WalUsage *dst, const WalUsage *add,
 							  const WalUsage *sub);
+extern void SessionVariableUsageAccumDiff(SessionVariableUsage *dst,
+										  const SessionVariableUsage *add,
+										  const SessionVariableUsage *sub);
 
 #endif							/* INSTRUMENT_H */
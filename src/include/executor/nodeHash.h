@@ -28,6 +28,9 @@ extern HashJoinTable ExecHashTableCreate(HashState *state);
 extern void ExecParallelHashTableAlloc(HashJoinTable hashtable,
 									   int batchno);
 extern void ExecHashTableDestroy(HashJoinTable hashtable);
+extern void ExecHashBuildBloomFilter(HashJoinTable hashtable, double ntuples);
+extern bool ExecHashBloomFilterRejects(HashJoinTable hashtable,
+									   uint32 hashvalue);
 extern void ExecHashTableDetach(HashJoinTable hashtable);
 extern void ExecHashTableDetachBatch(HashJoinTable hashtable);
 extern void ExecParallelHashTableSetCurrentBatch(HashJoinTable hashtable,
@@ -1112,6 +1112,17 @@ typedef struct JsonExprState
  */
 typedef TupleTableSlot *(*ExecProcNodeMtd) (struct PlanState *pstate);
 
+/* ----------------
+ *	 ExecProcNodeBatchMtd
+ *
+ * Optional method of nodes able to return several tuples per call, see
+ * ExecProcNodeBatch().  It stores up to maxslots slots into slots[] and
+ * returns their number, 0 only if no more tuples are available.
+ * ----------------
+ */
+typedef int (*ExecProcNodeBatchMtd) (struct PlanState *pstate,
+									 TupleTableSlot **slots, int maxslots);
+
 /* ----------------
  *		PlanState node
  *
@@ -1134,6 +1145,7 @@ typedef struct PlanState
 	ExecProcNodeMtd ExecProcNode;	/* function to return next tuple */
 	ExecProcNodeMtd ExecProcNodeReal;	/* actual function, if above is a
 										 * wrapper */
+	ExecProcNodeBatchMtd ExecProcNodeBatch; /* batch mode function, or NULL */
 
 	Instrumentation *instrument;	/* Optional runtime stats for this node */
 	WorkerInstrumentation *worker_instrument;	/* per-worker instrumentation */
@@ -1365,6 +1377,7 @@ typedef struct ModifySessionVariableState
 {
     PlanState	ps;				/* its first field is NodeTag */
     bool		mt_done;		/* are we done? */
+    TupleTableSlot *mt_row;		/* row to assign if assignColumns */
 } ModifySessionVariableState;
 
 /* ----------------
@@ -1596,6 +1609,7 @@ typedef struct SeqScanState
 {
 	ScanState	ss;				/* its first field is NodeTag */
 	Size		pscan_len;		/* size of parallel heap scan descriptor */
+	TupleTableSlot **batch_slots;	/* slots for batch mode, or NULL */
 } SeqScanState;
 
 /* ----------------
@@ -2224,6 +2238,11 @@ typedef struct MergeJoinState
  *		hj_JoinState			current state of ExecHashJoin state machine
  *		hj_MatchedOuter			true if found a join match for current outer
  *		hj_OuterNotEmpty		true if outer relation known not empty
+ *		hj_OuterBatch			outer tuples fetched in batch mode, or NULL
+ *		hj_OuterBatchHash		hash values of the tuples in hj_OuterBatch
+ *		hj_OuterBatchIsNull		true if the tuple's hash key is NULL
+ *		hj_OuterBatchCount		number of tuples in hj_OuterBatch
+ *		hj_OuterBatchNext		next tuple to return from hj_OuterBatch
  * ----------------
  */
 
@@ -2249,6 +2268,11 @@ typedef struct HashJoinState
 	int			hj_JoinState;
 	bool		hj_MatchedOuter;
 	bool		hj_OuterNotEmpty;
+	TupleTableSlot **hj_OuterBatch;
+	uint32	   *hj_OuterBatchHash;
+	bool	   *hj_OuterBatchIsNull;
+	int			hj_OuterBatchCount;
+	int			hj_OuterBatchNext;
 } HashJoinState;
 
 
@@ -2540,6 +2564,12 @@ typedef struct AggState
 	Tuplesortstate *sort_in;	/* sorted input to phases > 1 */
 	Tuplesortstate *sort_out;	/* input is copied here for next phase */
 	TupleTableSlot *sort_slot;	/* slot for sort results */
+	TupleTableSlot **input_batch;	/* input tuples fetched in batch mode, or
+									 * NULL if the input has no batch mode */
+	int			input_batch_count;	/* # of tuples in input_batch */
+	int			input_batch_next;	/* next tuple to return from input_batch */
+	uint32	   *input_batch_hash;	/* hash values of input_batch, if their
+									 * buckets are prefetched */
 	/* these fields are used in AGG_PLAIN and AGG_SORTED modes: */
 	AggStatePerGroup *pergroups;	/* grouping set indexed array of per-group
 									 * pointers */
@@ -2770,6 +2800,9 @@ typedef struct HashInstrumentation
 	int			nbatch;			/* number of batches at end of execution */
 	int			nbatch_original;	/* planned number of batches */
 	Size		space_peak;		/* peak memory usage in bytes */
+	Size		bloom_space;	/* Bloom filter size in bytes, or 0 */
+	double		bloom_checked;	/* outer tuples checked against it */
+	double		bloom_rejected; /* outer tuples it rejected */
 } HashInstrumentation;
 
 /* ----------------
@@ -164,6 +164,8 @@ typedef struct Query
 	bool		hasGroupRTE pg_node_attr(query_jumble_ignore);
 	/* is a RETURN statement */
 	bool		isReturn pg_node_attr(query_jumble_ignore);
+	/* is SELECT ... INTO @var, assigning its output columns */
+	bool		isSesVarInto;
 
 	List	   *cteList;		/* WITH list (of CommonTableExpr's) */
 
@@ -2672,7 +2674,10 @@ typedef struct VariableShowStmt
 typedef struct SetSessionVariableStmt
 {
     NodeTag		type;
-    List	   *variables; /* List of ResTarget */
+    /* from the parser */
+    List	   *variables pg_node_attr(query_jumble_ignore); /* List of ResTarget */
+    /* transformed assignments (TargetEntry), set for simple statements */
+    List	   *targetList;
 } SetSessionVariableStmt;
 
 /* ----------------------
@@ -3331,6 +3336,8 @@ typedef struct SecLabelStmt
 #define CURSOR_OPT_GENERIC_PLAN 0x0200	/* force use of generic plan */
 #define CURSOR_OPT_CUSTOM_PLAN	0x0400	/* force use of custom plan */
 #define CURSOR_OPT_PARALLEL_OK	0x0800	/* parallel mode OK */
+#define CURSOR_OPT_NO_SESVAR_PEEK 0x1000	/* plan is reused, don't estimate
+											 * with session variable values */
 
 typedef struct DeclareCursorStmt
 {
@@ -164,6 +164,12 @@ typedef struct PlannerGlobal
 	/* worst PROPARALLEL hazard level */
 	char		maxParallelHazard;
 
+	/* does the query assign any session variables? */
+	bool		hasSesVarAssignments;
+
+	/* may estimates use the current values of session variables? */
+	bool		peekSesVars;
+
 	/* partition descriptors */
 	PartitionDirectory partition_directory pg_node_attr(read_write_ignore);
 } PlannerGlobal;
@@ -92,6 +92,9 @@ typedef struct PlannedStmt
 
 	List	   *paramExecTypes; /* type OIDs for PARAM_EXEC Params */
 
+	List	   *sessionVariables;	/* names (String) of session variables
+									 * read by the plan */
+
 	Node	   *utilityStmt;	/* non-null if this is utility stmt */
 
 	/* statement location in source string (copied from Query) */
@@ -260,6 +263,9 @@ typedef struct ModifySessionVariable
 {
     Plan		plan;
     CmdType		operation;		/* SET_SESSION_VARIABLE */
+    bool		assignColumns;	/* assign the subplan output columns to the
+                                 * variables they are named after, see
+                                 * SELECT ... INTO @var */
 } ModifySessionVariable;
 
 struct PartitionPruneInfo;		/* forward reference to struct below */
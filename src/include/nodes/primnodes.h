@@ -160,6 +160,8 @@ typedef struct IntoClause
 	NodeTag		type;
 
 	RangeVar   *rel;			/* target relation name */
+	List	   *sesvars;		/* session variables (ColumnRefs) to assign
+								 * by SELECT ... INTO @var, rel is NULL */
 	List	   *colNames;		/* column names to assign, or NIL */
 	char	   *accessMethod;	/* table access method */
 	List	   *options;		/* options from WITH clause */
@@ -1403,8 +1405,10 @@ typedef struct SesVarExpr
     Oid			collid pg_node_attr(query_jumble_ignore);
     /* session variable id = @var */
     char        *name;
-    /* array indirection */
-    List        *indirection;
+    /* array subscript (int4) of @var[i] := ..., or NULL */
+    Expr        *upperindex;
+    /* lower bound of an array slice @var[i:j] := ..., or NULL */
+    Expr        *lowerindex;
     /* Strict type */
     bool        strict_type;
     /* token location, or -1 if unknown */
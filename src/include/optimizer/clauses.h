@@ -32,6 +32,9 @@ extern double expression_returns_set_rows(PlannerInfo *root, Node *clause);
 
 extern bool contain_subplans(Node *clause);
 
+extern bool contain_sesvar_assignment(Node *clause);
+extern bool contain_sesvar_reads(Node *clause);
+
 extern char max_parallel_hazard(Query *parse);
 extern bool is_parallel_safe(PlannerInfo *root, Node *node);
 extern bool contain_nonstrict_functions(Node *clause);
@@ -361,12 +361,20 @@ typedef struct ParseCallbackState
 	ErrorContextCallback errcallback;
 } ParseCallbackState;
 
-#define SESVAR_SIZE (NAMEDATALEN + 1)
+#define SESVAR_SIZE (NAMEDATALEN + 2)
 
 typedef struct sessionVariable {
     char key[SESVAR_SIZE];
     bool strict_type;
     Node *expr;
+    struct SessionVariablePin *pin; /* Readers holding expr's value by reference */
+    uint64 version;                 /* @@var: shared version expr was copied from */
+    uint64 checked;                 /* @@var: shared generation last checked at */
+    struct GlobalVariableEntry *shared; /* @@var: shared entry, never moves */
+    Size published;                 /* @@var: shared size of that version */
+    int64 reads;                    /* # of reads, see pg_stat_session_variables */
+    int64 writes;                   /* # of assignments */
+    Size size;                      /* memory held by expr's value */
 } sessionVariable;
 
 
@@ -207,6 +207,8 @@ typedef enum BuiltinTrancheIds
 	LWTRANCHE_LAUNCHER_HASH,
 	LWTRANCHE_DSM_REGISTRY_DSA,
 	LWTRANCHE_DSM_REGISTRY_HASH,
+	LWTRANCHE_GLOBAL_VARIABLES_DSA,
+	LWTRANCHE_GLOBAL_VARIABLES_HASH,
 	LWTRANCHE_COMMITTS_SLRU,
 	LWTRANCHE_MULTIXACTMEMBER_SLRU,
 	LWTRANCHE_MULTIXACTOFFSET_SLRU,
@@ -133,6 +133,8 @@ typedef struct CachedPlanSource
 	double		total_custom_cost;	/* total cost of custom plans so far */
 	int64		num_custom_plans;	/* # of custom plans included in total */
 	int64		num_generic_plans;	/* # of generic plans */
+	int64		num_sesvar_invalidations;	/* # of invalidations due to
+											 * session variable type changes */
 } CachedPlanSource;
 
 /*
@@ -224,6 +226,11 @@ extern CachedPlan *GetCachedPlan(CachedPlanSource *plansource,
 								 ParamListInfo boundParams,
 								 ResourceOwner owner,
 								 QueryEnvironment *queryEnv);
+extern CachedPlan *GetCachedPlanExt(CachedPlanSource *plansource,
+									ParamListInfo boundParams,
+									ResourceOwner owner,
+									QueryEnvironment *queryEnv,
+									bool sesvarCustomPlans);
 extern void ReleaseCachedPlan(CachedPlan *plan, ResourceOwner owner);
 
 extern bool CachedPlanAllowsSimpleValidityCheck(CachedPlanSource *plansource,
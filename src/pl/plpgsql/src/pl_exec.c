@@ -101,6 +101,37 @@ static SimpleEcontextStackEntry *simple_econtext_stack = NULL;
  */
 static ResourceOwner shared_simple_eval_resowner = NULL;
 
+/*
+ * Assignments to session variables (SELECT ... INTO @var) are not written
+ * to the session store right away.  The value stays in the @var datum of the
+ * executing function and the write is queued here, in assignment order.
+ * The queue is flushed by plpgsql_flush_session_variables, which is
+ * installed as session_variable_flush_hook so that it runs before anyone
+ * reads or writes session variables, and which the call handlers run when
+ * a function is entered and when it returns.  So a loop assigning the same
+ * @var many times costs one write-back, not one per assignment, with the
+ * same visible behavior.  A function failing with an error still writes back
+ * the assignments it made before the error
+ * (plpgsql_flush_session_variables_on_error), just as if they had been
+ * written right away; the queue never holds assignments of its callers,
+ * those are flushed when it is entered.
+ *
+ * The type of the value is kept with the queued write, since the datum
+ * (and its datatype, which is shared by all activations of the function)
+ * always claims to be text.
+ */
+typedef struct PLpgSQL_sesvar_write
+{
+	PLpgSQL_var *var;			/* datum holding the value */
+	Oid			type;			/* type of the value */
+	int32		typmod;
+	Oid			collation;
+	int16		typlen;
+	bool		typbyval;
+} PLpgSQL_sesvar_write;
+
+static List *pending_sesvar_writes = NIL;	/* in TopMemoryContext */
+
 /*
  * Memory management within a plpgsql function generally works with three
  * contexts:
@@ -356,6 +387,10 @@ static void exec_assign_value(PLpgSQL_execstate *estate,
 							  PLpgSQL_datum *target,
 							  Datum value, bool isNull,
 							  Oid valtype, int32 valtypmod);
+static void exec_assign_sesvar(PLpgSQL_execstate *estate,
+							   PLpgSQL_var *var,
+							   Datum value, bool isNull,
+							   Oid valtype, int32 valtypmod);
 static void exec_eval_datum(PLpgSQL_execstate *estate,
 							PLpgSQL_datum *datum,
 							Oid *typeid,
@@ -5094,9 +5129,17 @@ exec_assign_value(PLpgSQL_execstate *estate,
 				 */
 				PLpgSQL_var *var = (PLpgSQL_var *) target;
 				Datum		newvalue;
-                int16 typLen;
-                bool typByVal;
-                
+
+                /*
+                 * SESVAR is not cast to the type of the datum, it keeps the type of the assigned value
+                 * and is written back to the session later on, see exec_assign_sesvar
+                 **/
+                if (var->refname[0] == '@')
+                {
+                    exec_assign_sesvar(estate, var, value, isNull, valtype, valtypmod);
+                    break;
+                }
+
 				newvalue = exec_cast_value(estate,
 										   value,
 										   &isNull,
@@ -5111,16 +5154,6 @@ exec_assign_value(PLpgSQL_execstate *estate,
 							 errmsg("null value cannot be assigned to variable \"%s\" declared NOT NULL",
 									var->refname)));
 
-                /*
-                 * SESVAR doesn't have strict type -> just inherits it from the data that are being saved 
-                 **/
-                if(var->refname[0] == '@') {
-                    get_typlenbyval(valtype, &typLen, &typByVal);
-                    
-                    var->isnull = isNull;
-                    var->datatype->typbyval = typByVal;
-                }
-                
 				/*
 				 * If type is by-reference, copy the new value (which is
 				 * probably in the eval_mcontext) into the procedure's main
@@ -5172,21 +5205,6 @@ exec_assign_value(PLpgSQL_execstate *estate,
 									  (!var->datatype->typbyval && !isNull));
 				else
 					var->promise = PLPGSQL_PROMISE_NONE;
-
-                /*
-                 * If the var is a session variable
-                 * Save the value in memory
-                 */
-                if(var->refname[0] == '@')
-                    setSessionVariable(var->refname,
-                                       makeConstSessionVariable(
-                                               valtype,
-                                               valtypmod,
-                                               var->datatype->collation,
-                                               typByVal,
-                                               typLen,
-                                               isNull,
-                                               value), NIL, false);
 				break;
 			}
 
@@ -5315,6 +5333,195 @@ exec_assign_value(PLpgSQL_execstate *estate,
 	}
 }
 
+/*
+ * exec_assign_sesvar			Put a value into a session variable datum
+ *
+ * The value is stored in the datum as is, without a cast, and its write-back
+ * to the session store is queued (see pending_sesvar_writes).
+ */
+static void
+exec_assign_sesvar(PLpgSQL_execstate *estate, PLpgSQL_var *var,
+				   Datum value, bool isNull,
+				   Oid valtype, int32 valtypmod)
+{
+	PLpgSQL_sesvar_write *write = NULL;
+	MemoryContext oldcontext;
+	Const	   *con;
+	int16		typlen;
+	bool		typbyval;
+
+	get_typlenbyval(valtype, &typlen, &typbyval);
+
+	/*
+	 * Only the store is deferred: the coercion to a strictly typed variable
+	 * and the memory limit check happen right here, so that their errors are
+	 * raised by the assignment, where an exception block can catch them.
+	 */
+	oldcontext = MemoryContextSwitchTo(get_eval_mcontext(estate));
+	con = prepareSessionVariableValue(var->refname,
+									  (Const *) makeConstSessionVariable(valtype, valtypmod,
+																		 var->datatype->collation,
+																		 typbyval, typlen,
+																		 isNull, value));
+	MemoryContextSwitchTo(oldcontext);
+
+	value = con->constvalue;
+	isNull = con->constisnull;
+	valtype = con->consttype;
+	valtypmod = con->consttypmod;
+	typlen = con->constlen;
+	typbyval = con->constbyval;
+
+	/*
+	 * Copy the value into the procedure's main memory context.  We always
+	 * store a flat, detoasted copy: it must survive a COMMIT in a procedure
+	 * and it lets us free the old value with a plain pfree.
+	 */
+	if (!isNull && !typbyval)
+	{
+		if (typlen == -1 && VARATT_IS_EXTERNAL_NON_EXPANDED(DatumGetPointer(value)))
+			value = PointerGetDatum(detoast_external_attr((struct varlena *) DatumGetPointer(value)));
+		else
+			value = datumCopy(value, false, typlen);
+	}
+
+	if (var->freeval)
+		pfree(DatumGetPointer(var->value));
+	var->value = value;
+	var->isnull = isNull;
+	var->freeval = !isNull && !typbyval;
+
+	/*
+	 * Queue the write-back.  A datum assigned again in a loop usually is the
+	 * last one queued already, otherwise it moves behind all the others, so
+	 * that the flush keeps the assignment order.
+	 */
+	if (pending_sesvar_writes != NIL &&
+		((PLpgSQL_sesvar_write *) llast(pending_sesvar_writes))->var == var)
+		write = (PLpgSQL_sesvar_write *) llast(pending_sesvar_writes);
+	else
+	{
+		ListCell   *lc;
+
+		oldcontext = MemoryContextSwitchTo(TopMemoryContext);
+
+		foreach(lc, pending_sesvar_writes)
+		{
+			if (((PLpgSQL_sesvar_write *) lfirst(lc))->var == var)
+			{
+				write = (PLpgSQL_sesvar_write *) lfirst(lc);
+				pending_sesvar_writes = foreach_delete_current(pending_sesvar_writes, lc);
+				break;
+			}
+		}
+
+		if (write == NULL)
+		{
+			write = (PLpgSQL_sesvar_write *) palloc(sizeof(PLpgSQL_sesvar_write));
+			write->var = var;
+		}
+		pending_sesvar_writes = lappend(pending_sesvar_writes, write);
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	write->type = valtype;
+	write->typmod = valtypmod;
+	write->collation = con->constcollid;
+	write->typlen = typlen;
+	write->typbyval = typbyval;
+
+	session_variable_flush_hook = plpgsql_flush_session_variables;
+}
+
+/*
+ * plpgsql_flush_session_variables		Write back queued @var assignments
+ *
+ * Must be called before any of the datums holding the queued values goes
+ * away, i.e. whenever control leaves a function normally.
+ */
+void
+plpgsql_flush_session_variables(void)
+{
+	List	   *writes = pending_sesvar_writes;
+	ListCell   *lc;
+
+	if (writes == NIL)
+		return;
+
+	/*
+	 * Detach the whole queue before writing anything.  The writes below
+	 * access the session store, which must not call us back, and should one
+	 * of them fail, nothing is left queued that points to datums about to go
+	 * away.  Assignments queued meanwhile (by a PL/pgSQL function run by one
+	 * of the writes) install the hook again.
+	 */
+	pending_sesvar_writes = NIL;
+	session_variable_flush_hook = NULL;
+
+	PG_TRY();
+	{
+		foreach(lc, writes)
+		{
+			PLpgSQL_sesvar_write *write = (PLpgSQL_sesvar_write *) lfirst(lc);
+			PLpgSQL_var *var = write->var;
+
+			setSessionVariable(var->refname,
+							   makeConstSessionVariable(write->type,
+														write->typmod,
+														write->collation,
+														write->typbyval,
+														write->typlen,
+														var->isnull,
+														var->value),
+							   NULL, false);
+		}
+	}
+	PG_FINALLY();
+	{
+		list_free_deep(writes);
+	}
+	PG_END_TRY();
+}
+
+/*
+ * plpgsql_flush_session_variables_on_error	Write back queued @var
+ *		assignments of a failing function
+ *
+ * Called first thing on the error path of the call handlers, while the
+ * datums holding the queued values still exist.  If anything is queued, the
+ * error being thrown is set aside so that the writes can run, and returned;
+ * the caller must rethrow it with ReThrowError() instead of PG_RE_THROW().
+ * Should a write fail too, the remaining ones are dropped and its error is
+ * discarded, the error of the function is the one to report.  Returns NULL
+ * if nothing was queued, the error is left alone then.
+ */
+ErrorData *
+plpgsql_flush_session_variables_on_error(void)
+{
+	ErrorData  *edata;
+
+	if (pending_sesvar_writes == NIL)
+		return NULL;
+
+	MemoryContextSwitchTo(CurTransactionContext);
+	edata = CopyErrorData();
+	FlushErrorState();
+
+	PG_TRY();
+	{
+		plpgsql_flush_session_variables();
+	}
+	PG_CATCH();
+	{
+		MemoryContextSwitchTo(CurTransactionContext);
+		FlushErrorState();
+	}
+	PG_END_TRY();
+
+	return edata;
+}
+
 /*
  * exec_eval_datum				Get current value of a PLpgSQL_datum
  *
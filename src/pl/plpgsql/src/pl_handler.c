@@ -232,6 +232,12 @@ plpgsql_call_handler(PG_FUNCTION_ARGS)
 		IsA(fcinfo->context, CallContext) &&
 		!castNode(CallContext, fcinfo->context)->atomic;
 
+	/*
+	 * Write back the @var assignments of our callers first, so that the
+	 * queue only holds our own if this function fails (see below).
+	 */
+	plpgsql_flush_session_variables();
+
 	/*
 	 * Connect to SPI manager
 	 */
@@ -277,9 +283,19 @@ plpgsql_call_handler(PG_FUNCTION_ARGS)
 										   NULL, NULL,
 										   procedure_resowner,
 										   !nonatomic);
+
+		/* Write back @var assignments while their datums still exist */
+		plpgsql_flush_session_variables();
 	}
 	PG_FINALLY();
 	{
+		/*
+		 * If the function failed, write back the @var assignments it made
+		 * before that while their datums still exist.  Nothing is left queued
+		 * after a normal return.
+		 */
+		ErrorData  *edata = plpgsql_flush_session_variables_on_error();
+
 		/* Decrement use-count, restore cur_estate */
 		func->use_count--;
 		func->cur_estate = save_cur_estate;
@@ -290,6 +306,9 @@ plpgsql_call_handler(PG_FUNCTION_ARGS)
 			ReleaseAllPlanCacheRefsInOwner(procedure_resowner);
 			ResourceOwnerDelete(procedure_resowner);
 		}
+
+		if (edata != NULL)
+			ReThrowError(edata);
 	}
 	PG_END_TRY();
 
@@ -322,6 +341,9 @@ plpgsql_inline_handler(PG_FUNCTION_ARGS)
 	Datum		retval;
 	int			rc;
 
+	/* Write back the @var assignments of our callers first, see above */
+	plpgsql_flush_session_variables();
+
 	/*
 	 * Connect to SPI manager
 	 */
@@ -368,9 +390,15 @@ plpgsql_inline_handler(PG_FUNCTION_ARGS)
 									   simple_eval_resowner,
 									   simple_eval_resowner,	/* see above */
 									   codeblock->atomic);
+
+		/* Write back @var assignments while their datums still exist */
+		plpgsql_flush_session_variables();
 	}
 	PG_CATCH();
 	{
+		/* The block failed, write back the @var assignments it made first */
+		ErrorData  *edata = plpgsql_flush_session_variables_on_error();
+
 		/*
 		 * We need to clean up what would otherwise be long-lived resources
 		 * accumulated by the failed DO block, principally cached plans for
@@ -402,6 +430,8 @@ plpgsql_inline_handler(PG_FUNCTION_ARGS)
 		plpgsql_free_function_memory(func);
 
 		/* And propagate the error */
+		if (edata != NULL)
+			ReThrowError(edata);
 		PG_RE_THROW();
 	}
 	PG_END_TRY();
@@ -1458,6 +1458,29 @@ explain (costs off)
    where (hundred, thousand) in (select twothousand, twothousand from onek);
 reset enable_memoize;
 
+--
+-- Aggregates fetching their input from a Seq Scan in batches
+--
+
+create temp table agg_batch as
+select g as a, g % 10 as b from generate_series(1, 1000) g;
+analyze agg_batch;
+
+-- tuples failing the qual are filtered out of each batch
+explain (analyze, costs off, summary off, timing off)
+  select count(*), sum(a) from agg_batch where b < 3;
+select count(*), sum(a) from agg_batch where b < 3;
+
+-- rescans, one per outer row
+explain (analyze, costs off, summary off, timing off)
+  select x, (select count(*) from agg_batch where b = x) from generate_series(0, 2) x;
+select x, (select count(*) from agg_batch where b = x) from generate_series(0, 2) x;
+
+-- grouped
+select b, count(*), sum(a) from agg_batch group by b order by b;
+
+drop table agg_batch;
+
 --
 -- Hash Aggregation Spill tests
 --
@@ -1527,6 +1550,7 @@ select (g/2)::numeric as c1, array_agg(g::numeric) as c2, count(*) as c3
 
 set enable_hashagg = true;
 set enable_sort = false;
+set hash_prefetch_depth = 8;
 
 set jit_above_cost = 0;
 
@@ -1559,6 +1583,7 @@ create table agg_hash_4 as
 select (g/2)::numeric as c1, array_agg(g::numeric) as c2, count(*) as c3
   from agg_data_2k group by g/2;
 
+reset hash_prefetch_depth;
 set enable_sort = true;
 set work_mem to default;
 
@@ -53,6 +53,28 @@ begin
 end;
 $$;
 
+-- Extract whether a Bloom filter was built for the hash join, and how
+-- many outer tuples it checked and rejected.
+create or replace function hash_join_bloom(query text)
+returns table (built bool, checked int, rejects bool) language plpgsql
+as
+$$
+declare
+  whole_plan json;
+  hash_node json;
+begin
+  for whole_plan in
+    execute 'explain (analyze, format ''json'') ' || query
+  loop
+    hash_node := find_hash(json_extract_path(whole_plan, '0', 'Plan'));
+    built := hash_node->>'Bloom Filter Size' is not null;
+    checked := hash_node->>'Bloom Filter Checked';
+    rejects := coalesce((hash_node->>'Bloom Filter Rejected')::int > 0, false);
+    return next;
+  end loop;
+end;
+$$;
+
 -- Make a simple relation with well distributed keys and correctly
 -- estimated size.
 create table simple as
@@ -293,6 +315,47 @@ $$
 $$);
 rollback to settings;
 
+-- Multi-batch joins that discard unmatched outer tuples filter them
+-- through a Bloom filter of the inner hash values before batching
+
+-- non-parallel
+savepoint settings;
+set local max_parallel_workers_per_gather = 0;
+set local work_mem = '128kB';
+set local hash_mem_multiplier = 1.0;
+select count(*) from (select id + 15000 as id from simple) r join simple s using (id);
+select count(*) from (select id + 15000 as id from simple) r left join simple s using (id);
+select count(*) from (select id + 15000 as id from simple) r
+  where not exists (select 1 from simple s where s.id = r.id);
+select * from hash_join_bloom(
+$$
+  select count(*) from (select id * 7919 % 80000 as id from simple) r join simple s using (id);
+$$);
+-- no filter when unmatched outer tuples are emitted
+select * from hash_join_bloom(
+$$
+  select count(*) from (select id * 7919 % 80000 as id from simple) r full join simple s using (id);
+$$);
+rollback to settings;
+
+-- Prefetching the hash buckets of outer tuples fetched in batches must
+-- not change the results, whether or not the join is batched
+savepoint settings;
+set local max_parallel_workers_per_gather = 0;
+set local work_mem = '4MB';
+set local hash_mem_multiplier = 1.0;
+set local hash_prefetch_depth = 8;
+select count(*), sum(s.id) from simple r
+  left join (select id + 15000 as id from simple where id % 4 = 0) s using (id);
+set local hash_prefetch_depth = 0;
+select count(*), sum(s.id) from simple r
+  left join (select id + 15000 as id from simple where id % 4 = 0) s using (id);
+set local work_mem = '128kB';
+select count(*), sum(r.id) from simple r join simple s using (id);
+set local hash_prefetch_depth = 8;
+select count(*), sum(r.id) from simple r join simple s using (id);
+rollback to settings;
+
 -- A couple of other hash join tests unrelated to work_mem management.
 
 -- Check that EXPLAIN ANALYZE has data even if the leader doesn't participate
@@ -1,3 +1,9 @@
+-- The whole suite runs with JIT compilation forced, so that every session
+-- variable read and assign step is also covered by the JIT code paths
+SET jit_above_cost = 0;
+SET jit_inline_above_cost = 0;
+SET jit_optimize_above_cost = 0;
+
 -------------------------------------------- SET ----------------------------------------------------------
 -- Simple assigning ------------------------
 -- Set variable
@@ -112,6 +118,22 @@ SET @num := '5';
 SELECT @num;
 SELECT @num::INT;
 
+-- Reading as a domain checks its constraints
+CREATE DOMAIN positive_int AS INT CHECK (VALUE > 0);
+SELECT @num::positive_int;
+SET @num := -5;
+SELECT @num::positive_int; -- should fail
+DROP DOMAIN positive_int;
+
+-- Reading as another type prints the value and reads it back, on every path
+SET @cast_bp := 'ab'::CHAR(4),
+    @cast_arr := ARRAY [1, 2, 3],
+    @cast_f4 := 1.1::REAL,
+    @cast_num := 1.5;
+SELECT @cast_bp::TEXT || '|', @cast_arr::BIGINT[], @cast_arr::NUMERIC[];
+SELECT @cast_f4::FLOAT8 FROM generate_series(1, 2);
+SELECT @cast_num::INT;
+
 -- Remember inline types
 SET @dat := '2024-01-01'::DATE,
     @intv := '1 MONTH'::INTERVAL,
@@ -180,6 +202,26 @@ SET @arr[4] := 4; -- should fail
 
 SET @arr[-1] := 4; -- should fail
 
+SET @arr := ARRAY [['a', 'b'], ['c', 'd']];
+
+SET @arr[3] := 'x';
+
+SELECT @arr;
+
+SELECT @arr, @arr[1] := 'y', @arr; -- readers keep the old value
+
+SET @arr := ARRAY [0, 0, 0];
+
+SELECT @arr[num] := num * 10 FROM GENERATE_SERIES(1, 3) num;
+
+SET @i := 2;
+
+SET @arr[@i:@i + 1] := 5;
+
+SELECT @arr;
+
+SET @arr[NULL] := 1; -- should fail
+
 SET @arr := ARRAY [(5, 'ahoj')::TEST_TYPE, (3, 'jakje')::TEST_TYPE];
 
 SELECT @arr, (@arr[1]).a, (@arr[1]).b;
@@ -384,6 +426,12 @@ FROM test;
 SELECT @c := 1, @c := @c + col_int, @c := 'Text', @c := @c || ' ' || col_char
 FROM test;
 
+-- Value read before it is reassigned in the same row keeps the old value
+SET @s := 'a';
+
+SELECT @s, @s := @s || '!', @s
+FROM GENERATE_SERIES(1, 3, 1) num;
+
 -- Usage in queries ------------------------
 SET @char_int := '5',
     @created_int := @char_int + 3,
@@ -545,6 +593,9 @@ FROM test
 GROUP BY col_int;
 
 -------------------------------------------- EXPLAIN -----------------------------------------------------
+-- JIT details depend on build options, keep them out of the costed plans
+SET jit = off;
+
 EXPLAIN
 SELECT @agg := @bgg := @agg + col_int, COUNT(*)
 FROM test
@@ -575,6 +626,8 @@ FROM test
 GROUP BY 1
 ORDER BY 1 DESC;
 
+RESET jit;
+
 -------------------------------------------- STRICT TYPE ------------------------------------------------
 
 SET @d_strict := 5;
@@ -791,6 +844,24 @@ DROP FUNCTION overloaded_text_numeric(str TEXT);
 
 DROP FUNCTION overloaded_text_numeric(str NUMERIC);
 
+-- Only plans referencing the sesvar get invalidated
+SET @p1 := 5,
+    @p2 := 'x';
+
+PREPARE sesvar_stmt AS SELECT @p1 + 1;
+
+EXECUTE sesvar_stmt;
+
+SET @p2 := 10;
+
+SET @p1 := 5.5;
+
+EXECUTE sesvar_stmt;
+
+SELECT name, sesvar_invalidations FROM pg_prepared_statements WHERE name = 'sesvar_stmt';
+
+DEALLOCATE sesvar_stmt;
+
 
 -- SELECT ... INTO SESVAR ------------------
 DO
@@ -859,6 +930,79 @@ $$;
 
 SELECT @x, @y; -- should fail
 
+-- Assignments are written back before reads and on return, dropped on error
+CREATE FUNCTION sesvar_into_loop() RETURNS TEXT AS
+$$
+DECLARE
+    i INT;
+    seen TEXT := '';
+BEGIN
+    FOR i IN 1..3
+        LOOP
+            SELECT i INTO @into_cnt;
+            seen := seen || @into_cnt;
+        END LOOP;
+    SELECT 'last', 10 INTO @into_txt, @into_cnt;
+    RETURN seen;
+END;
+$$ LANGUAGE plpgsql;
+
+SELECT sesvar_into_loop();
+
+SELECT @into_cnt, @into_txt;
+
+DROP FUNCTION sesvar_into_loop();
+
+-- Assignments made before an error are kept, as if written right away
+DO -- should fail
+$$
+    BEGIN
+        SELECT 'kept' INTO @into_err;
+        RAISE EXCEPTION 'boom';
+    END;
+$$;
+
+SELECT @into_err;
+
+CREATE FUNCTION sesvar_into_fail() RETURNS VOID AS
+$$
+    BEGIN
+        SELECT 'kept' INTO @into_fail;
+        RAISE EXCEPTION 'boom';
+    END;
+$$ LANGUAGE plpgsql;
+
+SELECT sesvar_into_fail(); -- should fail
+SELECT @into_fail;
+
+DROP FUNCTION sesvar_into_fail();
+
+-- Casts and the memory limit are checked by the assignment itself
+CREATE DOMAIN into_positive AS INT CHECK (VALUE > 0);
+SET @into_strict TYPE into_positive := 1;
+SET session_variables_memory_limit = '64kB';
+
+DO
+$$
+    BEGIN
+        BEGIN
+            SELECT -1 INTO @into_strict;
+        EXCEPTION WHEN check_violation THEN
+            RAISE NOTICE 'caught: %', SQLERRM;
+        END;
+        BEGIN
+            SELECT REPEAT('x', 100000) INTO @into_big;
+        EXCEPTION WHEN configuration_limit_exceeded THEN
+            RAISE NOTICE 'caught: %', SQLERRM;
+        END;
+        SELECT 2 INTO @into_strict;
+    END;
+$$;
+
+RESET session_variables_memory_limit;
+SELECT @into_strict;
+SELECT @into_big; -- should fail
+
 -- EXECUTE ---------------------------------
 DO
 $$
@@ -884,5 +1028,275 @@ $$;
 
 SELECT @existing;
 
+-- Memory ----------------------------------
+-- By-reference values get a memory context of their own
+SET @mem_text := 'Memory',
+    @mem_int := 5;
+
+SELECT name, ident, level
+FROM pg_backend_memory_contexts
+WHERE name = 'Session variables' OR ident IN ('@mem_text', '@mem_int')
+ORDER BY level;
+
+-- JIT -------------------------------------
+-- JIT compilation is forced at the top of the file, check both steps together
+SET @jit_sum := 0,
+    @jit_arr := ARRAY [0, 0, 0];
+
+SELECT num, @jit_sum := @jit_sum + num, @jit_arr[num] := @jit_sum
+FROM GENERATE_SERIES(1, 3, 1) num;
+
+SELECT @jit_sum, @jit_arr;
+
+-- Parallel query --------------------------
+-- Values of the read session variables are passed to the workers,
+-- queries assigning session variables stay in the leader
+SET @par_lim := 3,
+    @par_txt := 'abc';
+SET debug_parallel_query = on;
+
+SELECT @par_txt, COUNT(*) FROM GENERATE_SERIES(1, 10) num WHERE num > @par_lim;
+
+SELECT @par_lim := @par_lim + 1;
+
+RESET debug_parallel_query;
+
+-- Simple SET ------------------------------
+-- Evaluated without the planner, in order
+SET @simple_a := 1, @simple_b := @simple_a + 1, @simple_s := 'x' || @simple_b;
+
+SELECT @simple_a, @simple_b, @simple_s;
+
+-- Statements with sublinks keep going through the planner
+SET @simple_a := (SELECT MAX(num) FROM GENERATE_SERIES(1, 5) num);
+
+SELECT @simple_a;
+
+-- PL/pgSQL variables are passed as parameters
+DO
+$$
+    DECLARE
+        i INT;
+    BEGIN
+        FOR i IN 1..3
+            LOOP
+                SET @simple_a := i, @simple_b := @simple_b + i;
+            END LOOP;
+    END;
+$$ LANGUAGE plpgsql;
+
+SELECT @simple_a, @simple_b;
+
+-- EXPLAIN shows, and with ANALYZE runs, the planned form
+EXPLAIN (COSTS OFF) SET @simple_e := 1;
+EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF) SET @simple_e := 2;
+SELECT @simple_e;
+
+-- Planner estimates ----------------------
+-- The current value is used for estimates, skewed columns get good plans
+CREATE TABLE sesvar_skew (id INT, val INT);
+INSERT INTO sesvar_skew
+SELECT num, CASE WHEN num % 1000 = 0 THEN num ELSE 0 END
+FROM GENERATE_SERIES(1, 10000) num;
+CREATE INDEX sesvar_skew_val ON sesvar_skew (val);
+ANALYZE sesvar_skew;
+
+SET @skew := 0;
+EXPLAIN (COSTS OFF) SELECT id FROM sesvar_skew WHERE val = @skew;
+
+SET @skew := 5000;
+EXPLAIN (COSTS OFF) SELECT id FROM sesvar_skew WHERE val = @skew;
+
+-- Statements reading session variables get custom plans as well
+PREPARE skew_stmt AS SELECT id FROM sesvar_skew WHERE val = @skew;
+EXPLAIN (COSTS OFF) EXECUTE skew_stmt;
+
+SET @skew := 0;
+EXPLAIN (COSTS OFF) EXECUTE skew_stmt;
+
+DEALLOCATE skew_stmt;
+
+-- PL/pgSQL simple expressions keep reusing their generic plan
+CREATE FUNCTION sesvar_simple_return() RETURNS INT AS
+$$
+BEGIN
+    RETURN @skew;
+END;
+$$ LANGUAGE plpgsql;
+
+SELECT sesvar_simple_return();
+SET @skew := 7;
+SELECT sesvar_simple_return();
+DROP FUNCTION sesvar_simple_return();
+
+-- Assigning queries cannot use session variables as index keys
+SET @skew := 5000;
+EXPLAIN (COSTS OFF) SELECT @skew := id FROM sesvar_skew WHERE val = @skew;
+
+DROP TABLE sesvar_skew;
+
+-- Partition pruning ----------------------
+-- Session variables are stable during execution and prune partitions
+CREATE TABLE sesvar_part (a INT) PARTITION BY LIST (a);
+CREATE TABLE sesvar_part_p1 PARTITION OF sesvar_part FOR VALUES IN (1);
+CREATE TABLE sesvar_part_p2 PARTITION OF sesvar_part FOR VALUES IN (2);
+CREATE TABLE sesvar_part_p3 PARTITION OF sesvar_part FOR VALUES IN (3);
+INSERT INTO sesvar_part SELECT num % 3 + 1 FROM GENERATE_SERIES(1, 30) num;
+
+SET @part := 2;
+EXPLAIN (COSTS OFF) SELECT * FROM sesvar_part WHERE a = @part;
+SELECT COUNT(*) FROM sesvar_part WHERE a = @part;
+
+-- Generic plans prune at executor startup
+PREPARE part_stmt AS SELECT * FROM sesvar_part WHERE a = @part;
+SET plan_cache_mode = force_generic_plan;
+EXPLAIN (COSTS OFF) EXECUTE part_stmt;
+RESET plan_cache_mode;
+DEALLOCATE part_stmt;
+
+-- Not when the query itself assigns session variables
+EXPLAIN (COSTS OFF) SELECT @part := a FROM sesvar_part WHERE a = @part;
+
+-- Neither in other commands nor with parallel query disabled
+CREATE TABLE sesvar_part_log (a INT);
+EXPLAIN (COSTS OFF)
+INSERT INTO sesvar_part_log SELECT @part := a FROM sesvar_part WHERE a = @part;
+
+SET max_parallel_workers_per_gather = 0;
+EXPLAIN (COSTS OFF) SELECT @part := a FROM sesvar_part WHERE a = @part;
+RESET max_parallel_workers_per_gather;
+DROP TABLE sesvar_part_log;
+
+DROP TABLE sesvar_part;
+
+-- Global variables -----------------------
+-- @@ directly followed by a name is still an operator
+SELECT to_tsvector('simple', 'fat cat') @@to_tsquery('simple', 'cat') AS fn,
+       tsv @@q AS col
+FROM (VALUES (to_tsvector('simple', 'fat cat'), to_tsquery('simple', 'rat'))) v(tsv, q);
+
+-- @"@var" is shared by all sessions of the cluster
+SET @"@gv_rate" := 1.5, @gv_local := 'session';
+SELECT @"@gv_rate", @gv_local, @"@gv_rate" * 2 AS doubled;
+
+SET @"@gv_arr" := ARRAY [1, 2, 3];
+SET @"@gv_arr"[2] := 20;
+SELECT @"@gv_arr";
+
+\c -
+SET jit_above_cost = 0;
+SET jit_inline_above_cost = 0;
+SET jit_optimize_above_cost = 0;
+SELECT @"@gv_rate", @"@gv_arr";
+
+SET @"@gv_rate" := @"@gv_rate" + 1;
+SELECT @"@gv_rate";
+
+-- Assigning them takes pg_write_global_variables, reading them does not
+CREATE ROLE regress_sesvar_global;
+SET ROLE regress_sesvar_global;
+SELECT @"@gv_rate";
+SET @"@gv_rate" := 0; -- should fail
+RESET ROLE;
+GRANT pg_write_global_variables TO regress_sesvar_global;
+SET ROLE regress_sesvar_global;
+SET @"@gv_arr"[1] := 10;
+SELECT @"@gv_arr";
+RESET ROLE;
+DROP ROLE regress_sesvar_global;
+
+-- Snapshot / restore ---------------------
+-- All session variables move to another session in one call
+SET @snap_int := 42, @snap_txt := 'text', @snap_arr := ARRAY [1, 2, 3];
+SET @snap_date TYPE DATE := '2024-01-01';
+SELECT pg_session_variables_snapshot() AS snap \gset
+
+\c -
+SET jit_above_cost = 0;
+SET jit_inline_above_cost = 0;
+SET jit_optimize_above_cost = 0;
+SET @snap_other := 1;
+SELECT pg_session_variables_restore(:'snap');
+SELECT @snap_int, @snap_txt, @snap_arr, @snap_date;
+SET @snap_date := 'dds'; -- should fail
+SELECT @snap_other; -- should fail
+SELECT @"@gv_rate";
+
+SELECT pg_session_variables_restore('\x00'); -- should fail
+
+-- Instrumentation ------------------------
+-- EXPLAIN reports the session variable work of each plan node
+SET @instr_acc := 0, @instr_txt := 'abc'::TEXT, @instr_num := '42'::TEXT, @instr_arr := ARRAY [0];
+EXPLAIN (ANALYZE, SESSION_VARIABLES, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT @instr_acc := @instr_acc + num FROM GENERATE_SERIES(1, 5) num;
+EXPLAIN (ANALYZE, SESSION_VARIABLES, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT @instr_txt := @instr_txt || 'x' FROM GENERATE_SERIES(1, 3) num;
+EXPLAIN (ANALYZE, SESSION_VARIABLES, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT num + @instr_num::INT FROM GENERATE_SERIES(1, 2) num;
+-- Arrays are kept expanded, they count with their flat size
+EXPLAIN (ANALYZE, SESSION_VARIABLES, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT @instr_arr := ARRAY [num, num] FROM GENERATE_SERIES(1, 2) num;
+EXPLAIN (SESSION_VARIABLES) SELECT @instr_acc; -- should fail
+SELECT name, type, size, reads, writes FROM pg_stat_session_variables
+WHERE name LIKE '@instr%' ORDER BY name;
+
+-- Row bound ------------------------------
+-- Assignments stop reading the subplan after the second row
+SET @bound := (SELECT num FROM GENERATE_SERIES(1, 1000) num ORDER BY num DESC); -- should fail
+SET @bound := (SELECT num FROM GENERATE_SERIES(1, 1000) num ORDER BY num DESC LIMIT 1);
+SELECT @bound;
+SET @bound := GENERATE_SERIES(1, 3); -- should fail
+
+-- Select into ----------------------------
+-- All variables are assigned from one pass over the query
+SELECT MIN(num), MAX(num), COUNT(*) INTO @into_min, @into_max, @into_cnt
+FROM GENERATE_SERIES(1, 10) num WHERE num % 2 = 0;
+SELECT @into_min, @into_max, @into_cnt;
+SELECT num, num * 10 INTO @into_min, @into_max
+FROM GENERATE_SERIES(1, 10) num ORDER BY num LIMIT 1;
+SELECT @into_min, @into_max;
+SELECT num INTO @into_min FROM GENERATE_SERIES(1, 10) num WHERE num > 10;
+SELECT @into_min;
+SELECT num INTO @into_min FROM GENERATE_SERIES(1, 10) num; -- should fail
+SELECT @into_min;
+SELECT 1, 2 INTO @into_min; -- should fail
+SELECT 1 INTO @into_min, @into_max; -- should fail
+SELECT * INTO @into_min FROM GENERATE_SERIES(1, 1); -- should fail
+SELECT 1 INTO @into_min UNION SELECT 2; -- should fail
+
+-- Assignments in the target list see the rows before ORDER BY sorts them
+SET @into_rn := 0;
+SELECT @into_rn := @into_rn + 1 AS rn, x FROM (VALUES (3), (1), (2)) v(x) ORDER BY x;
+
+-- Memory limit ----------------------------
+-- Values of session variables are accounted against session_variables_memory_limit
+\c -
+SET jit_above_cost = 0;
+SET jit_inline_above_cost = 0;
+SET jit_optimize_above_cost = 0;
+SET session_variables_memory_limit = '64kB';
+SET @mem_small := REPEAT('x', 1000);
+\set VERBOSITY terse
+SET @mem_big := REPEAT('x', 100000); -- should fail
+SET @mem_small := REPEAT('x', 100000); -- should fail
+SET @mem_arr := ARRAY ['x'];
+SET @mem_arr[1] := REPEAT('x', 100000); -- should fail
+\set VERBOSITY default
+SELECT LENGTH(@mem_small), @mem_arr;
+SELECT @mem_big; -- should fail
+SET @mem_small := 'x';
+RESET session_variables_memory_limit;
+SET @mem_big := REPEAT('x', 100000);
+SELECT LENGTH(@mem_big), LENGTH(@mem_small);
+SELECT pg_session_variables_snapshot() AS mem_snap \gset
+SET @mem_big := 'x';
+SET session_variables_memory_limit = '64kB';
+\set VERBOSITY terse
+SELECT pg_session_variables_restore(:'mem_snap'); -- should fail
+\set VERBOSITY default
+SELECT @mem_big, LENGTH(@mem_small), @mem_arr;
+RESET session_variables_memory_limit;
+
 -- Clean -----------------------------------
-DROP TABLE test;
\ No newline at end of file
+DROP TABLE test;
+DROP DOMAIN into_positive;
\ No newline at end of file
@@ -269,6 +269,28 @@ FROM (
 ROLLBACK;
 
 
+----
+-- test radix sorting of integer keys
+----
+
+CREATE TEMP TABLE radix_sort_ints AS
+    SELECT (g % 2003 - 1000) * 1000003 AS i4,
+           (g % 2003 - 1000) * 1000000007::int8 AS i8,
+           g
+    FROM generate_series(1, 10000) g;
+INSERT INTO radix_sort_ints VALUES (NULL, NULL, 0), (NULL, NULL, 10001);
+
+-- compare with sorts on numeric, which are not radix sorted
+
+SELECT
+    array_agg(i4 ORDER BY i4) = array_agg(i4 ORDER BY i4::numeric) AS i4_asc,
+    array_agg(i4 ORDER BY i4 DESC NULLS LAST) = array_agg(i4 ORDER BY i4::numeric DESC NULLS LAST) AS i4_desc,
+    array_agg(i8 ORDER BY i8 NULLS FIRST) = array_agg(i8 ORDER BY i8::numeric NULLS FIRST) AS i8_asc,
+    array_agg(i8 ORDER BY i8 DESC) = array_agg(i8 ORDER BY i8::numeric DESC) AS i8_desc,
+    array_agg(g ORDER BY i4, g DESC) = array_agg(g ORDER BY i4::numeric, g DESC) AS multi_key
+FROM radix_sort_ints;
+
+
 ----
 -- test tuplesort mark/restore
 ---
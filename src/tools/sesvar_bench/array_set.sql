@@ -0,0 +1,4 @@
+-- Per-row assignment of array elements through subscripts.
+\set rows 10000
+SET @arr := ARRAY_FILL(0, ARRAY [:rows]);
+SELECT COUNT(@arr[id] := val) FROM sesvar_bench_rows WHERE id <= :rows;
@@ -0,0 +1,71 @@
+#!/bin/sh
+
+# bench.sh
+#	Run the session variable benchmark scripts with pgbench.
+#
+# Usage: bench.sh [dbname]
+#
+# Connection parameters are taken from the usual libpq environment
+# variables (PGHOST, PGPORT, PGUSER, ...).  DURATION (seconds per script,
+# default 30) and CLIENTS (default 1) can be set in the environment.
+# BASELINE can name the saved output of an earlier run, whose tps is then
+# printed next to the new one together with their ratio.
+#
+# src/tools/sesvar_bench/bench.sh
+
+DBNAME=${1:-postgres}
+DURATION=${DURATION:-30}
+CLIENTS=${CLIENTS:-1}
+PGBENCH=${PGBENCH:-pgbench}
+PSQL=${PSQL:-psql}
+BASELINE=${BASELINE:-}
+
+DIR=$(dirname "$0")
+
+"$PSQL" -X -q -v ON_ERROR_STOP=1 -d "$DBNAME" -f "$DIR/setup.sql" || exit 1
+
+# run script mode [depth]
+#	depth is passed to the script as :depth and shown after its name
+run()
+{
+	script=$1
+	mode=$2
+	name=$script
+	defs=
+
+	if [ -n "$3" ]; then
+		name="$script:$3"
+		defs="-D depth=$3"
+	fi
+
+	tps=$("$PGBENCH" -n -M "$mode" -c "$CLIENTS" -j "$CLIENTS" -T "$DURATION" \
+		$defs -f "$DIR/$script" "$DBNAME" 2>&1 |
+		sed -n 's/^tps = \([0-9.]*\).*/\1/p')
+	if [ -z "$BASELINE" ]; then
+		printf '%-20s %-10s %12s\n' "$name" "$mode" "${tps:-failed}"
+		return
+	fi
+
+	base=$(awk -v s="$name" -v m="$mode" '$1 == s && $2 == m { print $3 }' "$BASELINE")
+	ratio=$(awk -v t="$tps" -v b="$base" 'BEGIN { if (t > 0 && b > 0) printf "%.3f", t / b }')
+	printf '%-20s %-10s %12s %12s %8s\n' "$name" "$mode" "${tps:-failed}" \
+		"${base:--}" "${ratio:--}"
+}
+
+if [ -n "$BASELINE" ]; then
+	printf '%-20s %-10s %12s %12s %8s\n' script mode tps baseline ratio
+else
+	printf '%-20s %-10s %12s\n' script mode tps
+fi
+
+run set_chain.sql simple
+run select_acc.sql simple
+run select_read.sql simple
+run array_set.sql simple
+run plpgsql_loop.sql simple
+run retype.sql simple
+run retype.sql prepared
+run hash_join.sql simple 0
+run hash_join.sql simple 8
+run hash_agg.sql simple 0
+run hash_agg.sql simple 8
@@ -0,0 +1,8 @@
+-- Hash aggregation into as many groups as there are rows, so that the hash
+-- table is much larger than the CPU caches.  bench.sh runs it with
+-- -D depth=0 and -D depth=8 to compare hash_prefetch_depth.
+SET hash_prefetch_depth = :depth;
+SET work_mem = '512MB';
+SET max_parallel_workers_per_gather = 0;
+SET enable_sort = off;
+SELECT COUNT(*) FROM (SELECT id, COUNT(*) FROM sesvar_bench_hash GROUP BY id) s;
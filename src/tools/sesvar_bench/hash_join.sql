@@ -0,0 +1,9 @@
+-- Hash join whose hash table is much larger than the CPU caches, probed
+-- with outer tuples fetched in batches.  bench.sh runs it with -D depth=0
+-- and -D depth=8 to compare hash_prefetch_depth.
+SET hash_prefetch_depth = :depth;
+SET work_mem = '512MB';
+SET max_parallel_workers_per_gather = 0;
+SET enable_mergejoin = off;
+SET enable_nestloop = off;
+SELECT COUNT(*) FROM sesvar_bench_hash a JOIN sesvar_bench_hash b USING (id);
@@ -0,0 +1,3 @@
+-- PL/pgSQL assignment of @var (SELECT ... INTO @var) inside a loop.
+\set n 10000
+SELECT sesvar_bench_loop(:n);
@@ -0,0 +1,9 @@
+-- Reads of a variable whose type changes between executions.
+-- Run with -M prepared to measure plan invalidation and replanning.
+\set flip random(0, 1)
+\if :flip
+SET @retype := 42;
+\else
+SET @retype := 'forty-two';
+\endif
+SELECT @retype;
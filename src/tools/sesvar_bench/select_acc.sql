@@ -0,0 +1,4 @@
+-- Per-row read and assignment of a scalar variable inside a query.
+\set rows 10000
+SET @acc := 0;
+SELECT COUNT(@acc := @acc + val) FROM sesvar_bench_rows WHERE id <= :rows;
@@ -0,0 +1,5 @@
+-- Per-row read of a variable in a qual, no assignment in the query
+-- (the plan may use parallel workers).
+\set lim random(1, 99)
+SET @lim := :lim;
+SELECT COUNT(*) FROM sesvar_bench_rows WHERE val > @lim;
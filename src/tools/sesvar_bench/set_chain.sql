@@ -0,0 +1,7 @@
+-- Chain of SET statements, each reading the previous variable.
+-- Measures the utility path of SET @var := expr.
+\set v random(1, 1000)
+SET @chain_a := :v;
+SET @chain_b := @chain_a + 1;
+SET @chain_c := @chain_b + 1, @chain_d := @chain_c * 2;
+SELECT @chain_d;
@@ -0,0 +1,32 @@
+-- Objects used by the session variable benchmark scripts.
+-- Run once against the benchmark database before bench.sh.
+
+DROP TABLE IF EXISTS sesvar_bench_rows;
+CREATE TABLE sesvar_bench_rows AS
+SELECT x AS id, x % 100 AS val
+FROM GENERATE_SERIES(1, 100000) x;
+ANALYZE sesvar_bench_rows;
+
+-- Large enough for the hash tables of hash_join.sql and hash_agg.sql to
+-- exceed the CPU caches
+DROP TABLE IF EXISTS sesvar_bench_hash;
+CREATE TABLE sesvar_bench_hash AS
+SELECT x AS id, x % 1000 AS val
+FROM GENERATE_SERIES(1, 2000000) x;
+ANALYZE sesvar_bench_hash;
+
+CREATE OR REPLACE FUNCTION sesvar_bench_loop(n INT)
+    RETURNS INT
+AS
+$$
+DECLARE
+    i INT;
+BEGIN
+    SELECT 0 INTO @pl_acc;
+    FOR i IN 1..n
+        LOOP
+            SELECT @pl_acc + i INTO @pl_acc;
+        END LOOP;
+    RETURN @pl_acc;
+END;
+$$ LANGUAGE plpgsql;